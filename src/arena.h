@@ -0,0 +1,71 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include "stats.h"
+//
+// QUERY ARENA
+//
+// monotonic memory for the intermediate vectors of one query: allocating is a pointer
+// bump, freeing does nothing, and reset() drops everything at once
+// one block is kept between queries, when a query overflows it into the heap the next
+// reset grows the block by as much, up to max_kept, so repeated queries of a similar
+// size stop touching malloc after the first
+class QueryArena
+{
+public:
+    explicit QueryArena(const std::size_t initial = 1 << 16, const std::size_t max_kept = 1 << 26)
+        : max_kept_(std::max(initial, max_kept))
+    {
+        allocate_block(initial);
+    }
+
+    QueryArena(const QueryArena&) = delete;
+    QueryArena& operator=(const QueryArena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &*resource_; }
+
+    void reset()
+    {
+        resource_->release();
+        const std::size_t wanted = std::min(block_size_ + overflow_.bytes, max_kept_);
+        overflow_.bytes = 0;
+        if(wanted > block_size_) allocate_block(wanted);
+    }
+
+private:
+    // heap blocks past the kept one, counted
+    struct Overflow : std::pmr::memory_resource
+    {
+        std::size_t bytes = 0;
+
+        void* do_allocate(const std::size_t size, const std::size_t align) override
+        {
+            bytes += size;
+            DP_STATS_BYTES(size);
+            return std::pmr::new_delete_resource()->allocate(size, align);
+        }
+        void do_deallocate(void *ptr, const std::size_t size, const std::size_t align) override
+        {
+            std::pmr::new_delete_resource()->deallocate(ptr, size, align);
+        }
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+    };
+
+    std::size_t max_kept_;
+    std::size_t block_size_ = 0;
+    std::unique_ptr<std::byte[]> block_;
+    Overflow overflow_;
+    std::optional<std::pmr::monotonic_buffer_resource> resource_;
+
+    void allocate_block(const std::size_t size)
+    {
+        DP_STATS_BYTES(size);
+        resource_.reset();
+        block_.reset(new std::byte[size]);
+        block_size_ = size;
+        resource_.emplace(block_.get(), block_size_, &overflow_);
+    }
+};
@@ -0,0 +1,366 @@
+//
+// BENCHMARKS
+//
+// every variant of every problem over a size sweep, reported as json on stdout
+//     g++ -std=c++20 -O2 -pthread src/bench.cpp -o bench
+//     ./bench [budget_ms] [memory_limit_mb] > bench.json
+// each case runs in a forked child, so a crash, a timeout or running out of memory
+// only ends that case, and peak RSS belongs to the case alone
+// once a variant goes over the budget its larger sizes are skipped
+#define DP_NO_MAIN
+#include "main.cpp"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+//
+// ALLOCATION COUNTER
+//
+static std::atomic<std::size_t> allocation_count{0};
+
+void* operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if(void *ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+// gcc can't tell the replaced operator new hands out malloc memory
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+#pragma GCC diagnostic pop
+
+template<typename T>
+void keep(const T &value)
+{
+    // stops the optimizer from dropping a result nobody reads
+    asm volatile("" : : "g"(&value) : "memory");
+}
+//
+// CASES
+//
+// a case turns a size into a ready to run operation, input building stays out of the timing
+struct Variant
+{
+    std::string name;
+    std::function<std::function<void()>(long long)> prepare;
+};
+
+struct Family
+{
+    std::string name;
+    std::vector<long long> sizes;
+    std::vector<Variant> variants;
+};
+
+template<typename F>
+Variant fib_variant(const std::string &name, F fib_fun)
+{
+    return { name, [=](long long n){ return std::function<void()>([=]{ keep(fib_fun(static_cast<int>(n))); }); } };
+}
+
+template<typename F>
+Variant grid_variant(const std::string &name, F grid_fun)
+{
+    return { name, [=](long long n){ return std::function<void()>([=]{ keep(grid_fun(static_cast<int>(n), static_cast<int>(n))); }); } };
+}
+
+// n x n, weights 1 to 9 and one cell in 16 a wall, sparse enough that a path stays open
+// the grid is shared, a copy of the 20k one alone would be 1.6 GB
+template<typename F>
+Variant weighted_grid_variant(const std::string &name, F grid_fun)
+{
+    return { name, [=](long long n){
+        const auto grid = std::make_shared<TiledGrid>(static_cast<int>(n), static_cast<int>(n));
+        std::uint32_t seed = 1;
+        for(int r = 0; r < n; ++r){
+            for(int c = 0; c < n; ++c){
+                seed = seed * 1'664'525 + 1'013'904'223;    // lcg
+                const bool corner = (r == 0 && c == 0) || (r == n - 1 && c == n - 1);
+                if((seed >> 28) == 0 && !corner) grid->block(r, c);
+                else grid->at(r, c) = 1 + (seed >> 16) % 9;
+            }
+        }
+        return std::function<void()>([=]{ keep(grid_fun(*grid)); });
+    } };
+}
+
+// odd targets over even numbers, nothing is reachable so every variant explores everything
+template<typename F>
+Variant sum_variant(const std::string &name, F sum_fun)
+{
+    return { name, [=](long long n){
+        const std::vector<int> numbers = { 2, 4 };
+        return std::function<void()>([=]{ keep(sum_fun(static_cast<int>(n | 1), numbers)); });
+    } };
+}
+
+// uk coins, the pricing kind of input
+template<typename F>
+Variant count_sum_variant(const std::string &name, F count_fun)
+{
+    return { name, [=](long long n){
+        const std::vector<int> coins = { 1, 2, 5, 10, 20, 50, 100, 200 };
+        return std::function<void()>([=]{ keep(count_fun(static_cast<int>(n), coins)); });
+    } };
+}
+
+// n queries, 128 bit n over 100 moduli of every kind: barrett, montgomery and even wide ones
+template<typename F>
+Variant fib_mod_variant(const std::string &name, F batch_fun)
+{
+    return { name, [=](long long n){
+        std::uint64_t seed = 1;
+        const auto next = [&]{
+            // splitmix64
+            std::uint64_t z = (seed += 0x9e3779b97f4a7c15);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            return z ^ (z >> 31);
+        };
+        std::vector<std::uint64_t> moduli(100);
+        for(std::size_t i = 0; i < moduli.size(); ++i) moduli[i] = (next() >> (i % 3 == 0 ? 34 : 20)) + 1;
+        std::vector<FibModQuery> queries(n);
+        for(FibModQuery &query : queries) query = { static_cast<uint128>(next()) << 64 | next(), moduli[next() % moduli.size()] };
+        return std::function<void()>([=]{ keep(batch_fun(queries)); });
+    } };
+}
+
+// "ee...ef", the classic input that defeats the unmemoized construct solvers
+template<typename F>
+Variant construct_variant(const std::string &name, F construct_fun)
+{
+    return { name, [=](long long n){
+        const std::string target = std::string(n, 'e') + 'f';
+        const std::vector<std::string> word_bank = { "e", "ee", "eee", "eeee", "eeeee", "eeeeee" };
+        return std::function<void()>([=]{ keep(construct_fun(target, word_bank)); });
+    } };
+}
+
+std::vector<Family> families()
+{
+    const std::vector<long long> sum_sizes = { 8, 16, 32, 64, 128, 1'000, 100'000, 10'000'000 };
+    const std::vector<long long> construct_sizes = { 8, 16, 24, 32, 1'000, 100'000 };
+    return {
+        { "fib", { 10, 20, 30, 40, 50, 93, 1'000, 100'000, 10'000'000 }, {
+            fib_variant("fib_recu", FibFunc(fib_recu)),
+            fib_variant("fib_memo", FibFunc(fib_memo)),
+            fib_variant("fib_stack", FibFunc(fib_stack)),
+            fib_variant("fib_spec", FibFunc(fib_spec)),
+            fib_variant("fib_tab", FibFunc(fib_tab)),
+            fib_variant("fib_doubling", FibFunc(fib_doubling)),
+            fib_variant("fib_lookup", FibFunc(fib_lookup)),
+            fib_variant("fib_big", fib_big),
+        } },
+        { "grid_traveler", { 4, 8, 12, 16, 18, 100, 1'000, 4'000 }, {
+            grid_variant("grid_traveler_recu", GridTravelerFunc(grid_traveler_recu)),
+            grid_variant("grid_traveler_memo", GridTravelerFunc(grid_traveler_memo)),
+            grid_variant("grid_traveler_spec", GridTravelerFunc(grid_traveler_spec)),
+            grid_variant("grid_traveler_tab", GridTravelerFunc(grid_traveler_tab)),
+            grid_variant("grid_traveler_roll", GridTravelerFunc(grid_traveler_roll<>)),
+            grid_variant("grid_traveler_lookup", GridTravelerFunc(grid_traveler_lookup)),
+            grid_variant("grid_traveler_mod", GridTravelerFunc(grid_traveler_mod)),
+            grid_variant("grid_traveler_binom", grid_traveler_binom),
+        } },
+        { "grid_traveler_weighted", { 100, 1'000, 4'000, 20'000 }, {
+            weighted_grid_variant("grid_traveler_paths", [](const TiledGrid &grid){ return grid_traveler_paths<ModCount<>>(grid); }),
+            weighted_grid_variant("grid_traveler_min_cost", [](const TiledGrid &grid){ return grid_traveler_min_cost(grid); }),
+            weighted_grid_variant("grid_traveler_max_reward", [](const TiledGrid &grid){ return grid_traveler_max_reward(grid); }),
+            weighted_grid_variant("grid_traveler_min_cost_pool", [](const TiledGrid &grid){
+                static ThreadPool pool;
+                return grid_traveler_min_cost(grid, &pool);
+            }),
+        } },
+        { "can_sum", sum_sizes, {
+            sum_variant("can_sum_recu", CanSumFunc(can_sum_recu)),
+            sum_variant("can_sum_memo", CanSumFunc(can_sum_memo)),
+            sum_variant("can_sum_stack", CanSumFunc(can_sum_stack)),
+            sum_variant("can_sum_tab", CanSumFunc(can_sum_tab)),
+            sum_variant("can_sum_bits", CanSumFunc(can_sum_bits)),
+            sum_variant("can_sum_spec", CanSumFunc(can_sum_spec)),
+        } },
+        { "how_sum", sum_sizes, {
+            sum_variant("how_sum_recu", SumFunc(how_sum_recu)),
+            sum_variant("how_sum_memo", SumFunc(how_sum_memo)),
+            sum_variant("how_sum_stack", SumFunc(how_sum_stack)),
+            sum_variant("how_sum_tab", SumFunc(how_sum_tab)),
+            sum_variant("how_sum_parent", SumFunc(how_sum_parent)),
+            sum_variant("how_sum_arena", SumFunc(how_sum_arena)),
+        } },
+        { "best_sum", sum_sizes, {
+            sum_variant("best_sum_recu", SumFunc(best_sum_recu)),
+            sum_variant("best_sum_memo", SumFunc(best_sum_memo)),
+            sum_variant("best_sum_stack", SumFunc(best_sum_stack)),
+            sum_variant("best_sum_tab", SumFunc(best_sum_tab)),
+            sum_variant("best_sum_parent", SumFunc(best_sum_parent)),
+            sum_variant("best_sum_blocked", SumFunc(best_sum_blocked)),
+            sum_variant("best_sum_arena", SumFunc(best_sum_arena)),
+            sum_variant("best_sum_spec", SumFunc(best_sum_spec)),
+        } },
+        { "count_sum", { 200, 10'000, 1'000'000, 100'000'000 }, {
+            count_sum_variant("count_sum_checked", count_sum_checked<>),
+            count_sum_variant("count_sum_ordered_checked", count_sum_checked<SumOrder::ordered>),
+            count_sum_variant("count_sum_big", count_sum_big<>),
+            count_sum_variant("count_sum_mod", count_sum_mod<>),
+            count_sum_variant("count_sum_ordered_mod", count_sum_mod<SumOrder::ordered>),
+        } },
+        { "fib_mod", { 1, 100, 10'000, 1'000'000 }, {
+            fib_mod_variant("fib_mod", [](const std::vector<FibModQuery> &queries){
+                std::vector<std::uint64_t> result;
+                for(const FibModQuery &query : queries) result.push_back(fib_mod(query.n, query.m));
+                return result;
+            }),
+            fib_mod_variant("fib_mod_pisano", [](const std::vector<FibModQuery> &queries){
+                PisanoCache cache;
+                std::vector<std::uint64_t> result;
+                for(const FibModQuery &query : queries) result.push_back(fib_mod(query.n, query.m, cache));
+                return result;
+            }),
+            fib_mod_variant("fib_mod_batch", [](const std::vector<FibModQuery> &queries){ return fib_mod_batch(queries); }),
+            fib_mod_variant("fib_mod_batch_pisano", [](const std::vector<FibModQuery> &queries){
+                PisanoCache cache;
+                return fib_mod_batch(queries, &cache);
+            }),
+        } },
+        { "can_construct", construct_sizes, {
+            construct_variant("can_construct_recu", CanConstructFunc(can_construct_recu)),
+            construct_variant("can_construct_memo", CanConstructFunc(can_construct_memo)),
+            construct_variant("can_construct_offset", CanConstructFunc(can_construct_offset)),
+            construct_variant("can_construct_stack", CanConstructFunc(can_construct_stack)),
+            construct_variant("can_construct_tab", CanConstructFunc(can_construct_tab)),
+        } },
+        { "count_construct", construct_sizes, {
+            construct_variant("count_construct_recu", CountConstructFunc(count_construct_recu)),
+            construct_variant("count_construct_memo", CountConstructFunc(count_construct_memo)),
+            construct_variant("count_construct_offset", CountConstructFunc(count_construct_offset)),
+            construct_variant("count_construct_stack", CountConstructFunc(count_construct_stack)),
+            construct_variant("count_construct_tab", CountConstructFunc(count_construct_tab)),
+            construct_variant("count_construct_spec", CountConstructFunc(count_construct_spec)),
+            construct_variant("count_construct_big", count_construct_big),
+            construct_variant("count_construct_checked", count_construct_checked),
+            construct_variant("count_construct_mod", count_construct_mod<>),
+        } },
+        { "all_construct", construct_sizes, {
+            construct_variant("all_construct_recu", AllConstructFunc(all_construct_recu)),
+            construct_variant("all_construct_memo", AllConstructFunc(all_construct_memo)),
+            construct_variant("all_construct_offset", AllConstructFunc(all_construct_offset)),
+            construct_variant("all_construct_stack", AllConstructFunc(all_construct_stack)),
+            construct_variant("all_construct_arena", AllConstructFunc(all_construct_arena)),
+            construct_variant("all_construct_tab", AllConstructFunc(all_construct_tab)),
+            construct_variant("all_construct_spec", AllConstructFunc(all_construct_spec)),
+            construct_variant("all_construct_dag", AllConstructFunc(all_construct_dag)),
+            construct_variant("all_construct_parallel", AllConstructFunc(all_construct_parallel)),
+            construct_variant("all_construct_gen", [](const std::string &target, const std::vector<std::string> &word_bank){
+                std::size_t ways = 0;
+                for(const std::vector<std::string_view> &way : all_construct_gen(target, word_bank)) ways += !way.empty();
+                return ways;
+            }),
+        } },
+    };
+}
+//
+// MEASUREMENT
+//
+struct Measurement
+{
+    double ns_per_op = 0;
+    double allocs_per_op = 0;
+    long peak_rss_kb = 0;
+    long long iterations = 0;
+    bool out_of_memory = false;
+};
+
+// runs inside the forked child
+Measurement measure(const Variant &variant, const long long size, const double min_time_ns)
+{
+    Measurement result;
+    try{
+        const std::function<void()> op = variant.prepare(size);
+        const std::size_t allocations_before = allocation_count.load();
+        const auto start = std::chrono::steady_clock::now();
+        double elapsed = 0;
+        do{
+            op();
+            ++result.iterations;
+            elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        } while(elapsed < min_time_ns);
+        result.ns_per_op = elapsed / result.iterations;
+        result.allocs_per_op = static_cast<double>(allocation_count.load() - allocations_before) / result.iterations;
+    }
+    catch(const std::bad_alloc&){
+        result.out_of_memory = true;
+    }
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    result.peak_rss_kb = usage.ru_maxrss;
+    return result;
+}
+
+// "ok", "timeout", "out_of_memory" or "crashed"
+std::string run_case(const Variant &variant, const long long size, const double budget_ms, const long memory_limit_mb, Measurement &result)
+{
+    int channel[2];
+    if(pipe(channel) != 0) return "crashed";
+    std::fflush(stdout);
+    const pid_t child = fork();
+    if(child == 0){
+        close(channel[0]);
+        const rlimit memory = { static_cast<rlim_t>(memory_limit_mb) << 20, static_cast<rlim_t>(memory_limit_mb) << 20 };
+        setrlimit(RLIMIT_AS, &memory);
+        alarm(static_cast<unsigned>(budget_ms * 3 / 1000) + 1);
+        const Measurement measured = measure(variant, size, std::min(budget_ms / 10, 100.0) * 1e6);
+        const ssize_t written = write(channel[1], &measured, sizeof(measured));
+        _exit(written == static_cast<ssize_t>(sizeof(measured)) ? 0 : 1);
+    }
+    close(channel[1]);
+    const ssize_t got = read(channel[0], &result, sizeof(result));
+    close(channel[0]);
+    int status = 0;
+    waitpid(child, &status, 0);
+    if(WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM) return "timeout";
+    if(got != static_cast<ssize_t>(sizeof(result))) return "crashed";
+    if(result.out_of_memory) return "out_of_memory";
+    return "ok";
+}
+
+int main(int argc, char **argv)
+{
+    const double budget_ms = argc > 1 ? std::atof(argv[1]) : 1'000;
+    const long memory_limit_mb = argc > 2 ? std::atol(argv[2]) : 2'048;
+
+    std::printf("{\n  \"budget_ms\": %.0f,\n  \"memory_limit_mb\": %ld,\n  \"results\": [", budget_ms, memory_limit_mb);
+    bool first = true;
+    for(const Family &family : families()){
+        for(const Variant &variant : family.variants){
+            std::string skip_reason;
+            for(const long long size : family.sizes){
+                std::printf("%s\n    {\"family\": \"%s\", \"variant\": \"%s\", \"size\": %lld, ",
+                    first ? "" : ",", family.name.c_str(), variant.name.c_str(), size);
+                first = false;
+                if(!skip_reason.empty()){
+                    std::printf("\"status\": \"skipped\", \"reason\": \"%s\"}", skip_reason.c_str());
+                    continue;
+                }
+                Measurement result;
+                const std::string status = run_case(variant, size, budget_ms, memory_limit_mb, result);
+                if(status != "ok"){
+                    std::printf("\"status\": \"%s\"}", status.c_str());
+                    skip_reason = status;
+                    continue;
+                }
+                std::printf("\"status\": \"ok\", \"ns_per_op\": %.1f, \"allocs_per_op\": %.2f, \"peak_rss_kb\": %ld, \"iterations\": %lld}",
+                    result.ns_per_op, result.allocs_per_op, result.peak_rss_kb, result.iterations);
+                if(result.ns_per_op > budget_ms * 1e6) skip_reason = "over_budget";
+            }
+        }
+    }
+    std::printf("\n  ]\n}\n");
+}
@@ -0,0 +1,254 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+//
+// BIG UNSIGNED INTEGER
+//
+// arbitrary precision non-negative integer, little-endian base 2^32 limbs
+// multiplication switches from schoolbook to karatsuba on large operands
+class BigUint
+{
+public:
+    using limb = std::uint32_t;
+
+    BigUint() = default;
+    BigUint(std::uint64_t value)
+    {
+        while(value){
+            limbs_.push_back(static_cast<limb>(value));
+            value >>= 32;
+        }
+    }
+
+    bool is_zero() const { return limbs_.empty(); }
+    std::size_t limb_count() const { return limbs_.size(); }
+    const std::vector<limb>& limbs() const { return limbs_; }
+
+    // low 64 bits, the same value an overflowing uint64_t computation gives
+    std::uint64_t low64() const
+    {
+        std::uint64_t value = 0;
+        if(limbs_.size() > 0) value |= limbs_[0];
+        if(limbs_.size() > 1) value |= static_cast<std::uint64_t>(limbs_[1]) << 32;
+        return value;
+    }
+
+    BigUint& operator+=(const BigUint &other)
+    {
+        if(limbs_.size() < other.limbs_.size()) limbs_.resize(other.limbs_.size(), 0);
+        limbs_.push_back(0);
+        add_into(limbs_.data(), limbs_.size(), other.limbs_.data(), other.limbs_.size());
+        trim();
+        return *this;
+    }
+
+    // requires *this >= other
+    BigUint& operator-=(const BigUint &other)
+    {
+        sub_into(limbs_.data(), limbs_.size(), other.limbs_.data(), other.limbs_.size());
+        trim();
+        return *this;
+    }
+
+    BigUint& operator*=(const BigUint &other)
+    {
+        *this = *this * other;
+        return *this;
+    }
+
+    friend BigUint operator+(BigUint lhs, const BigUint &rhs) { return lhs += rhs; }
+    friend BigUint operator-(BigUint lhs, const BigUint &rhs) { return lhs -= rhs; }
+
+    friend BigUint operator*(const BigUint &lhs, const BigUint &rhs)
+    {
+        BigUint result;
+        if(lhs.is_zero() || rhs.is_zero()) return result;
+        result.limbs_.assign(lhs.limbs_.size() + rhs.limbs_.size(), 0);
+        mul_rec(lhs.limbs_.data(), lhs.limbs_.size(), rhs.limbs_.data(), rhs.limbs_.size(), result.limbs_.data());
+        result.trim();
+        return result;
+    }
+
+    BigUint& mul_small(const limb factor)
+    {
+        std::uint64_t carry = 0;
+        for(limb &l : limbs_){
+            carry += static_cast<std::uint64_t>(l) * factor;
+            l = static_cast<limb>(carry);
+            carry >>= 32;
+        }
+        if(carry) limbs_.push_back(static_cast<limb>(carry));
+        trim();
+        return *this;
+    }
+
+    // divides in place and returns the remainder
+    limb div_small(const limb divisor)
+    {
+        std::uint64_t rem = 0;
+        for(std::size_t i = limbs_.size(); i-- > 0;){
+            const std::uint64_t cur = (rem << 32) | limbs_[i];
+            limbs_[i] = static_cast<limb>(cur / divisor);
+            rem = cur % divisor;
+        }
+        trim();
+        return static_cast<limb>(rem);
+    }
+
+    limb mod_small(const limb divisor) const
+    {
+        std::uint64_t rem = 0;
+        for(std::size_t i = limbs_.size(); i-- > 0;)
+            rem = ((rem << 32) | limbs_[i]) % divisor;
+        return static_cast<limb>(rem);
+    }
+
+    friend int compare(const BigUint &lhs, const BigUint &rhs)
+    {
+        if(lhs.limbs_.size() != rhs.limbs_.size())
+            return lhs.limbs_.size() < rhs.limbs_.size() ? -1 : 1;
+        for(std::size_t i = lhs.limbs_.size(); i-- > 0;)
+            if(lhs.limbs_[i] != rhs.limbs_[i])
+                return lhs.limbs_[i] < rhs.limbs_[i] ? -1 : 1;
+        return 0;
+    }
+    friend bool operator==(const BigUint &lhs, const BigUint &rhs) { return lhs.limbs_ == rhs.limbs_; }
+    friend bool operator!=(const BigUint &lhs, const BigUint &rhs) { return !(lhs == rhs); }
+    friend bool operator<(const BigUint &lhs, const BigUint &rhs) { return compare(lhs, rhs) < 0; }
+    friend bool operator>(const BigUint &lhs, const BigUint &rhs) { return compare(lhs, rhs) > 0; }
+    friend bool operator<=(const BigUint &lhs, const BigUint &rhs) { return compare(lhs, rhs) <= 0; }
+    friend bool operator>=(const BigUint &lhs, const BigUint &rhs) { return compare(lhs, rhs) >= 0; }
+
+    std::string to_string() const
+    {
+        // O(n^2) time, peels 9 decimal digits per pass
+        if(is_zero()) return "0";
+        BigUint rest = *this;
+        std::vector<limb> chunks;
+        while(!rest.is_zero()) chunks.push_back(rest.div_small(1'000'000'000));
+
+        std::string str = std::to_string(chunks.back());
+        for(std::size_t i = chunks.size() - 1; i-- > 0;){
+            const std::string chunk = std::to_string(chunks[i]);
+            str.append(9 - chunk.size(), '0');
+            str += chunk;
+        }
+        return str;
+    }
+
+    friend std::ostream& operator<<(std::ostream &os, const BigUint &value)
+    {
+        return os << value.to_string();
+    }
+
+private:
+    // operands shorter than this (in limbs) use schoolbook multiplication
+    static constexpr std::size_t karatsuba_threshold = 32;
+
+    std::vector<limb> limbs_;
+
+    void trim()
+    {
+        while(!limbs_.empty() && limbs_.back() == 0) limbs_.pop_back();
+    }
+
+    // r[0..rn) += a[0..an), an <= rn, the carry must not leave r
+    static void add_into(limb *r, const std::size_t rn, const limb *a, const std::size_t an)
+    {
+        std::uint64_t carry = 0;
+        std::size_t i = 0;
+        for(; i < an; ++i){
+            carry += static_cast<std::uint64_t>(r[i]) + a[i];
+            r[i] = static_cast<limb>(carry);
+            carry >>= 32;
+        }
+        for(; carry && i < rn; ++i){
+            carry += r[i];
+            r[i] = static_cast<limb>(carry);
+            carry >>= 32;
+        }
+    }
+
+    // r[0..rn) -= a[0..an), requires r >= a
+    static void sub_into(limb *r, const std::size_t rn, const limb *a, const std::size_t an)
+    {
+        std::int64_t borrow = 0;
+        std::size_t i = 0;
+        for(; i < an; ++i){
+            std::int64_t cur = static_cast<std::int64_t>(r[i]) - a[i] - borrow;
+            borrow = cur < 0;
+            r[i] = static_cast<limb>(cur + (borrow << 32));
+        }
+        for(; borrow && i < rn; ++i){
+            borrow = r[i] == 0;
+            --r[i];
+        }
+    }
+
+    static std::size_t trimmed(const limb *a, std::size_t n)
+    {
+        while(n && a[n - 1] == 0) --n;
+        return n;
+    }
+
+    // r[0..na+nb) = a * b, r must be zeroed
+    static void mul_school(const limb *a, const std::size_t na, const limb *b, const std::size_t nb, limb *r)
+    {
+        // O(na * nb) time
+        for(std::size_t i = 0; i < na; ++i){
+            std::uint64_t carry = 0;
+            const std::uint64_t ai = a[i];
+            for(std::size_t j = 0; j < nb; ++j){
+                carry += ai * b[j] + r[i + j];
+                r[i + j] = static_cast<limb>(carry);
+                carry >>= 32;
+            }
+            r[i + nb] = static_cast<limb>(carry);
+        }
+    }
+
+    // r[0..na+nb) = a * b, r must be zeroed
+    static void mul_rec(const limb *a, std::size_t na, const limb *b, std::size_t nb, limb *r)
+    {
+        // O(n^1.585) time
+        if(na < nb){
+            std::swap(a, b);
+            std::swap(na, nb);
+        }
+        if(nb < karatsuba_threshold){
+            mul_school(a, na, b, nb, r);
+            return;
+        }
+        const std::size_t k = na / 2;
+        if(nb <= k){
+            // unbalanced, split only the longer operand
+            mul_rec(a, k, b, nb, r);
+            std::vector<limb> high(na - k + nb, 0);
+            mul_rec(a + k, na - k, b, nb, high.data());
+            add_into(r + k, na + nb - k, high.data(), trimmed(high.data(), high.size()));
+            return;
+        }
+        // a = a1 * B^k + a0, b = b1 * B^k + b0
+        // a * b = z2 * B^2k + (z1 - z2 - z0) * B^k + z0, z1 = (a0 + a1)(b0 + b1)
+        mul_rec(a, k, b, k, r);
+        mul_rec(a + k, na - k, b + k, nb - k, r + 2 * k);
+
+        std::vector<limb> sa(na - k + 1, 0);
+        std::copy(a + k, a + na, sa.begin());
+        add_into(sa.data(), sa.size(), a, k);
+        std::vector<limb> sb(std::max(k, nb - k) + 1, 0);
+        std::copy(b + k, b + nb, sb.begin());
+        add_into(sb.data(), sb.size(), b, k);
+
+        const std::size_t nsa = trimmed(sa.data(), sa.size());
+        const std::size_t nsb = trimmed(sb.data(), sb.size());
+        std::vector<limb> z1(nsa + nsb, 0);
+        mul_rec(sa.data(), nsa, sb.data(), nsb, z1.data());
+        sub_into(z1.data(), z1.size(), r, trimmed(r, 2 * k));
+        sub_into(z1.data(), z1.size(), r + 2 * k, trimmed(r + 2 * k, na + nb - 2 * k));
+        add_into(r + k, na + nb - k, z1.data(), trimmed(z1.data(), z1.size()));
+    }
+};
@@ -0,0 +1,247 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "simd.h"
+#include "stats.h"
+//
+// ADD MOD KERNEL
+//
+// dp[i] = (dp[i] + dp[i - c]) mod p for i in [from, to), i going up, so a number adds to
+// cells it already added to, the unbounded coin change step
+// the cells a vector reads are at least c below it, from two vectors up those are
+// already stored and come from memory
+// residues are below p < 2^31, so a + b fits in 32 bits and min(s, s - p) unsigned is s mod p
+
+using add_mod_kernel = void(*)(std::uint32_t *dp, std::size_t from, std::size_t to, std::size_t c, std::uint32_t p);
+
+inline void add_mod_scalar(std::uint32_t *dp, const std::size_t from, const std::size_t to, const std::size_t c, const std::uint32_t p)
+{
+    for(std::size_t i = from; i < to; ++i){
+        const std::uint32_t sum = dp[i] + dp[i - c];
+        dp[i] = std::min(sum, sum - p);
+    }
+}
+
+#if DP_X86_DISPATCH
+// a number below two vectors would load cells the previous vectors are still storing,
+// those come from registers instead: the last two result vectors for c in [lanes, 2 lanes),
+// and below lanes each vector is first scanned in place with strides c, 2c, 4c.. then
+// gets the last c results of the vector before it, lane j from lane lanes - c + j mod c
+
+DP_TARGET_AVX2 inline __m256i add_mod_8(const __m256i a, const __m256i b, const __m256i mod)
+{
+    const __m256i sum = _mm256_add_epi32(a, b);
+    return _mm256_min_epu32(sum, _mm256_sub_epi32(sum, mod));
+}
+
+DP_TARGET_AVX2 inline void add_mod_avx2(std::uint32_t *dp, const std::size_t from, const std::size_t to, const std::size_t c, const std::uint32_t p)
+{
+    constexpr std::size_t lanes = 8;
+    // the two vectors below the first one must be final
+    const std::size_t start = std::min(to, std::max(from, 2 * lanes));
+    add_mod_scalar(dp, from, start, c, p);
+    const __m256i mod = _mm256_set1_epi32(static_cast<int>(p));
+    std::size_t i = start;
+    if(c >= 2 * lanes){
+        for(; i + lanes <= to; i += lanes){
+            __m256i *to_cells = reinterpret_cast<__m256i*>(dp + i);
+            _mm256_storeu_si256(to_cells, add_mod_8(_mm256_loadu_si256(to_cells), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dp + i - c)), mod));
+        }
+    }
+    else if(i + lanes <= to){
+        __m256i prev2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dp + i - 2 * lanes));
+        __m256i prev1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dp + i - lanes));
+        if(c >= lanes){
+            alignas(32) int low[lanes], high[lanes], pick[lanes];
+            for(std::size_t j = 0; j < lanes; ++j){
+                const std::size_t at = 2 * lanes - c + j;
+                low[j] = high[j] = static_cast<int>(at % lanes);
+                pick[j] = at >= lanes ? -1 : 0;
+            }
+            const __m256i low_index = _mm256_load_si256(reinterpret_cast<const __m256i*>(low));
+            const __m256i high_index = _mm256_load_si256(reinterpret_cast<const __m256i*>(high));
+            const __m256i from_high = _mm256_load_si256(reinterpret_cast<const __m256i*>(pick));
+            for(; i + lanes <= to; i += lanes){
+                const __m256i src = _mm256_blendv_epi8(_mm256_permutevar8x32_epi32(prev2, low_index),
+                                                       _mm256_permutevar8x32_epi32(prev1, high_index), from_high);
+                const __m256i result = add_mod_8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(dp + i)), src, mod);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dp + i), result);
+                prev2 = prev1;
+                prev1 = result;
+            }
+        }
+        else{
+            __m256i shift_index[3], shift_mask[3];
+            int steps = 0;
+            for(std::size_t d = c; d < lanes; d *= 2, ++steps){
+                alignas(32) int index[lanes], mask[lanes];
+                for(std::size_t j = 0; j < lanes; ++j){
+                    index[j] = j >= d ? static_cast<int>(j - d) : 0;
+                    mask[j] = j >= d ? -1 : 0;
+                }
+                shift_index[steps] = _mm256_load_si256(reinterpret_cast<const __m256i*>(index));
+                shift_mask[steps] = _mm256_load_si256(reinterpret_cast<const __m256i*>(mask));
+            }
+            alignas(32) int carry[lanes];
+            for(std::size_t j = 0; j < lanes; ++j) carry[j] = static_cast<int>(lanes - c + j % c);
+            const __m256i carry_index = _mm256_load_si256(reinterpret_cast<const __m256i*>(carry));
+            for(; i + lanes <= to; i += lanes){
+                __m256i scan = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dp + i));
+                for(int step = 0; step < steps; ++step)
+                    scan = add_mod_8(scan, _mm256_and_si256(_mm256_permutevar8x32_epi32(scan, shift_index[step]), shift_mask[step]), mod);
+                prev1 = add_mod_8(scan, _mm256_permutevar8x32_epi32(prev1, carry_index), mod);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dp + i), prev1);
+            }
+        }
+    }
+    add_mod_scalar(dp, i, to, c, p);
+}
+
+// gcc 12 headers trip -Wmaybe-uninitialized inside the avx-512 intrinsics
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+DP_TARGET_AVX512 inline __m512i add_mod_16(const __m512i a, const __m512i b, const __m512i mod)
+{
+    const __m512i sum = _mm512_add_epi32(a, b);
+    return _mm512_min_epu32(sum, _mm512_sub_epi32(sum, mod));
+}
+
+DP_TARGET_AVX512 inline void add_mod_avx512(std::uint32_t *dp, const std::size_t from, const std::size_t to, const std::size_t c, const std::uint32_t p)
+{
+    constexpr std::size_t lanes = 16;
+    const std::size_t start = std::min(to, std::max(from, 2 * lanes));
+    add_mod_scalar(dp, from, start, c, p);
+    const __m512i mod = _mm512_set1_epi32(static_cast<int>(p));
+    std::size_t i = start;
+    if(c >= 2 * lanes){
+        for(; i + lanes <= to; i += lanes)
+            _mm512_storeu_si512(dp + i, add_mod_16(_mm512_loadu_si512(dp + i), _mm512_loadu_si512(dp + i - c), mod));
+    }
+    else if(i + lanes <= to){
+        __m512i prev2 = _mm512_loadu_si512(dp + i - 2 * lanes);
+        __m512i prev1 = _mm512_loadu_si512(dp + i - lanes);
+        if(c >= lanes){
+            alignas(64) int pair[lanes];
+            for(std::size_t j = 0; j < lanes; ++j) pair[j] = static_cast<int>(2 * lanes - c + j);
+            const __m512i pair_index = _mm512_load_si512(pair);
+            for(; i + lanes <= to; i += lanes){
+                const __m512i result = add_mod_16(_mm512_loadu_si512(dp + i), _mm512_permutex2var_epi32(prev2, pair_index, prev1), mod);
+                _mm512_storeu_si512(dp + i, result);
+                prev2 = prev1;
+                prev1 = result;
+            }
+        }
+        else{
+            __m512i shift_index[4];
+            __mmask16 shift_mask[4];
+            int steps = 0;
+            for(std::size_t d = c; d < lanes; d *= 2, ++steps){
+                alignas(64) int index[lanes];
+                for(std::size_t j = 0; j < lanes; ++j) index[j] = j >= d ? static_cast<int>(j - d) : 0;
+                shift_index[steps] = _mm512_load_si512(index);
+                shift_mask[steps] = static_cast<__mmask16>(0xffffu << d);
+            }
+            alignas(64) int carry[lanes];
+            for(std::size_t j = 0; j < lanes; ++j) carry[j] = static_cast<int>(lanes - c + j % c);
+            const __m512i carry_index = _mm512_load_si512(carry);
+            for(; i + lanes <= to; i += lanes){
+                __m512i scan = _mm512_loadu_si512(dp + i);
+                for(int step = 0; step < steps; ++step)
+                    scan = add_mod_16(scan, _mm512_maskz_permutexvar_epi32(shift_mask[step], shift_index[step], scan), mod);
+                prev1 = add_mod_16(scan, _mm512_permutexvar_epi32(carry_index, prev1), mod);
+                _mm512_storeu_si512(dp + i, prev1);
+            }
+        }
+    }
+    add_mod_scalar(dp, i, to, c, p);
+}
+#pragma GCC diagnostic pop
+#endif
+
+inline add_mod_kernel select_add_mod_kernel()
+{
+#if DP_X86_DISPATCH
+    if(cpu_has_avx512()) return add_mod_avx512;
+    if(cpu_has_avx2()) return add_mod_avx2;
+#endif
+    return add_mod_scalar;
+}
+//
+// COUNT SUM MOD
+//
+// ways[target] mod p, the numbers positive, distinct and ascending
+// only the answer is kept, the cells are swept in blocks that stay in the cache and a
+// block is forgotten once every number is done with it, O(block + numbers) memory for
+// any target, and no pass over a table too big for the cache
+
+// cells per block, 64 KiB of residues, raised to a few times the largest number
+constexpr std::size_t count_sum_block = 1 << 14;
+
+// unordered: the number order doesn't change the count, so every number goes over a block
+// before the next block starts, each one carrying the last c cells of its own pass over the
+// block before, which the numbers after it have since added to
+inline std::uint32_t count_sum_unordered_mod(const std::size_t target, const std::vector<int> &numbers, const std::uint32_t p)
+{
+    static const add_mod_kernel kernel = select_add_mod_kernel();
+    const std::size_t size = target + 1;
+    std::vector<std::size_t> fits;
+    for(int c : numbers) if(static_cast<std::size_t>(c) <= target) fits.push_back(c);
+    const std::size_t largest = fits.empty() ? 0 : fits.back();
+    const std::size_t block = std::min(size, std::max(count_sum_block, 4 * largest));
+
+    // a number's pass over the block runs from largest - c, its history copied in front
+    std::vector<std::uint32_t> cells(largest + block);
+    std::vector<std::vector<std::uint32_t>> history;
+    for(std::size_t c : fits) history.emplace_back(c, 0);
+    DP_STATS_BYTES(cells.size() * sizeof(std::uint32_t));
+    std::uint32_t *window = cells.data() + largest;
+    std::size_t b = 0, len = 0;
+    for(; b < size; b += block){
+        len = std::min(block, size - b);
+        std::fill(window, window + len, 0);
+        if(b == 0) window[0] = 1 % p;
+        for(std::size_t j = 0; j < fits.size(); ++j){
+            const std::size_t c = fits[j];
+            std::copy(history[j].begin(), history[j].end(), window - c);
+            kernel(window - c, c, c + len, c, p);
+            std::copy(window + len - c, window + len, history[j].begin());
+        }
+        if(b + len == size) break;
+    }
+    return window[len - 1];
+}
+
+// ordered: a cell reads the largest cells below it, those slide along in front of the block,
+// and inside the block the runs [i, i + smallest) only read cells below i, so each run
+// takes every number as one contiguous range like min_count_range does
+inline std::uint32_t count_sum_ordered_mod(const std::size_t target, const std::vector<int> &numbers, const std::uint32_t p)
+{
+    static const add_mod_kernel kernel = select_add_mod_kernel();
+    const std::size_t size = target + 1;
+    if(numbers.empty() || static_cast<std::size_t>(numbers.front()) > target) return target == 0 ? 1 % p : 0;
+    const std::size_t largest = std::min<std::size_t>(numbers.back(), target), step = numbers.front();
+    const std::size_t block = std::min(size, std::max(count_sum_block, 4 * largest));
+
+    // cells[x] is the cell b - largest + x
+    std::vector<std::uint32_t> cells(largest + block, 0);
+    DP_STATS_BYTES(cells.size() * sizeof(std::uint32_t));
+    std::size_t b = 0, len = 0;
+    for(; b < size; b += block){
+        len = std::min(block, size - b);
+        std::fill(cells.begin() + largest, cells.end(), 0);
+        if(b == 0) cells[largest] = 1 % p;
+        for(std::size_t i = std::max<std::size_t>(b, 1); i < b + len; i += step){
+            const std::size_t e = std::min(i + step, b + len);
+            for(int number : numbers){
+                const std::size_t c = number;
+                if(c >= e) break;
+                kernel(cells.data(), largest + std::max(i, c) - b, largest + e - b, c, p);
+            }
+        }
+        if(b + len == size) break;
+        std::copy(cells.begin() + len, cells.begin() + len + largest, cells.begin());
+    }
+    return cells[largest + len - 1];
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <iostream>
+//
+// COUNT TYPES
+//
+// drop-in replacements for int in the counting tabulations, the value type only
+// needs construction from an integer and +=
+
+// 64 bit count that flags overflow instead of wrapping around
+struct CheckedCount
+{
+    std::uint64_t value = 0;
+    bool overflow = false;
+
+    CheckedCount() = default;
+    CheckedCount(const std::uint64_t v) : value(v) {}
+
+    CheckedCount& operator+=(const CheckedCount &other)
+    {
+        const std::uint64_t sum = value + other.value;
+        overflow = overflow || other.overflow || sum < value;
+        value = sum;
+        return *this;
+    }
+
+    friend bool operator==(const CheckedCount &lhs, const CheckedCount &rhs)
+    {
+        return lhs.value == rhs.value && lhs.overflow == rhs.overflow;
+    }
+
+    friend std::ostream& operator<<(std::ostream &os, const CheckedCount &count)
+    {
+        if(count.overflow) return os << "overflow";
+        return os << count.value;
+    }
+};
+
+// count modulo a prime below 2^31, the sum of two residues never leaves 32 bits
+template<std::uint32_t P = 1'000'000'007>
+struct ModCount
+{
+    static_assert(P > 1 && P < (1u << 31), "ModCount modulus must fit in 31 bits");
+    static constexpr std::uint32_t modulus = P;
+
+    std::uint32_t value = 0;
+
+    ModCount() = default;
+    ModCount(const std::uint64_t v) : value(static_cast<std::uint32_t>(v % P)) {}
+
+    ModCount& operator+=(const ModCount &other)
+    {
+        value += other.value;
+        if(value >= P) value -= P;
+        return *this;
+    }
+
+    friend bool operator==(const ModCount &lhs, const ModCount &rhs) { return lhs.value == rhs.value; }
+
+    friend std::ostream& operator<<(std::ostream &os, const ModCount &count)
+    {
+        return os << count.value;
+    }
+};
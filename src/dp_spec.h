@@ -0,0 +1,261 @@
+#pragma once
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "memo.h"
+#include "memo_stack.h"
+#include "stats.h"
+//
+// DP COMBINE OPERATORS
+//
+// what the answer of a state is made of, given the answers of the states its transitions
+// lead to, a combine operator provides
+//     value_type
+//     value_type zero() const                 no path, where every fold starts
+//     value_type one() const                  the single empty path of a goal state
+//     void fold(value_type &acc, const value_type &child, const Label &label) const
+//                                             adds the child's paths, each behind label
+//     bool saturated(const value_type &acc) const     no further fold can change acc
+//     bool is_zero(const value_type &value) const
+struct DpOr
+{
+    using value_type = bool;
+    bool zero() const { return false; }
+    bool one() const { return true; }
+    template<typename Label>
+    void fold(bool &acc, const bool child, const Label&) const { acc = acc || child; }
+    bool saturated(const bool acc) const { return acc; }
+    bool is_zero(const bool value) const { return !value; }
+};
+
+// int, BigUint, CheckedCount or ModCount
+template<typename Count>
+struct DpCount
+{
+    using value_type = Count;
+    Count zero() const { return Count(0); }
+    Count one() const { return Count(1); }
+    template<typename Label>
+    void fold(Count &acc, const Count &child, const Label&) const { acc += child; }
+    bool saturated(const Count&) const { return false; }
+    bool is_zero(const Count &value) const { return value == Count(0); }
+};
+
+// forward lists the labels in the order the transitions are taken from the root, the way
+// a construction reads, backward the other way round, the way the sum variants list terms
+enum class DpPath { forward, backward };
+
+// the shortest path, the first one found among equals
+template<typename Label, DpPath Order = DpPath::forward>
+struct DpMinLength
+{
+    using value_type = std::optional<std::vector<Label>>;
+    value_type zero() const { return std::nullopt; }
+    value_type one() const { return std::vector<Label>{}; }
+    void fold(value_type &acc, const value_type &child, const Label &label) const
+    {
+        // only copied when it wins
+        if(!child || (acc && child->size() + 1 >= acc->size())) return;
+        std::vector<Label> &path = acc.emplace();
+        path.reserve(child->size() + 1);
+        if(Order == DpPath::forward) path.push_back(label);
+        path.insert(path.end(), child->begin(), child->end());
+        if(Order == DpPath::backward) path.push_back(label);
+    }
+    bool saturated(const value_type&) const { return false; }
+    bool is_zero(const value_type &value) const { return !value; }
+};
+
+// every path
+template<typename Label, DpPath Order = DpPath::forward>
+struct DpEnumerate
+{
+    using value_type = std::vector<std::vector<Label>>;
+    value_type zero() const { return {}; }
+    value_type one() const { return {{}}; }
+    void fold(value_type &acc, const value_type &child, const Label &label) const
+    {
+        for(const std::vector<Label> &child_path : child){
+            std::vector<Label> path;
+            path.reserve(child_path.size() + 1);
+            if(Order == DpPath::forward) path.push_back(label);
+            path.insert(path.end(), child_path.begin(), child_path.end());
+            if(Order == DpPath::backward) path.push_back(label);
+            acc.push_back(std::move(path));
+        }
+    }
+    bool saturated(const value_type&) const { return false; }
+    bool is_zero(const value_type &value) const { return value.empty(); }
+};
+//
+// DP SPEC
+//
+// one description of a problem, the solvers below are generated from it, a spec provides
+//     key_type, label_type, combine_type      a state, what a transition adds to a path, one of the above
+//     bool goal(key) const                    a base case, answered by combine_type::one()
+//     std::size_t transitions(key) const
+//     bool child(key, k, key_type &out) const the state transition k leads to, false if it leads nowhere
+//     label_type label(key, k) const
+// dense storage and dp_tab need integral keys in [0, bound(root)), every child on the
+// same side of its parent
+//     std::size_t bound(root) const
+//     static constexpr DpDirection direction
+// push order needs child turned around
+//     bool parent(key, k, key_type &out) const   the state whose transition k leads to key, false if none
+// keys must not lead back to themselves
+enum class DpDirection { down, up };    // children below or above their parent
+enum class DpOrder { pull, push };
+
+template<typename Spec>
+using DpValue = typename Spec::combine_type::value_type;
+
+template<typename Spec>
+concept DenseDpSpec = std::integral<typename Spec::key_type> && requires(const Spec &spec, const typename Spec::key_type &key){
+    { spec.bound(key) } -> std::convertible_to<std::size_t>;
+    { Spec::direction } -> std::convertible_to<DpDirection>;
+};
+
+template<typename Spec>
+concept PushDpSpec = DenseDpSpec<Spec> && requires(const Spec &spec, const typename Spec::key_type &key, typename Spec::key_type &out){
+    { spec.parent(key, std::size_t{}, out) } -> std::convertible_to<bool>;
+};
+
+// dense when the spec bounds its keys, hashed otherwise
+template<typename Spec>
+auto dp_storage(const Spec &spec, const typename Spec::key_type &root)
+{
+    if constexpr(DenseDpSpec<Spec>) return DenseMemo<DpValue<Spec>>(spec.bound(root));
+    else return FlatHashMemo<typename Spec::key_type, DpValue<Spec>>();
+}
+//
+// DP TOP DOWN
+//
+// a spec as a memo_stack_solve problem, only the states reachable from the root are visited
+template<typename Spec>
+struct DpTopDown
+{
+    using key_type = typename Spec::key_type;
+    using value_type = DpValue<Spec>;
+    using state_type = DpValue<Spec>;
+
+    const Spec &spec;
+    typename Spec::combine_type combine{};
+
+    bool base(const key_type &key, value_type &out) const
+    {
+        if(!spec.goal(key)) return false;
+        out = combine.one();
+        return true;
+    }
+    value_type start(const key_type&) const { return combine.zero(); }
+    std::size_t transitions(const key_type &key) const { return spec.transitions(key); }
+    bool child(const key_type &key, const std::size_t k, key_type &out) const { return spec.child(key, k, out); }
+    bool fold(const key_type &key, const std::size_t k, value_type &acc, const value_type &child) const
+    {
+        combine.fold(acc, child, spec.label(key, k));
+        return !combine.saturated(acc);
+    }
+    value_type finish(const key_type&, value_type &&acc) const { return std::move(acc); }
+};
+
+// remembers nothing, every state is solved again each time it is reached
+template<typename V>
+class DpNoMemo
+{
+public:
+    template<typename K>
+    const V* find(const K&) const { return nullptr; }
+
+    template<typename K>
+    V& store(const K&, V value)
+    {
+        last_ = std::move(value);
+        return last_;
+    }
+
+private:
+    V last_{};
+};
+
+// the recursion, exponential like the *_recu variants, but without their depth limit
+template<typename Spec>
+DpValue<Spec> dp_recu(const Spec &spec, const typename Spec::key_type &root)
+{
+    DpNoMemo<DpValue<Spec>> memo;
+    return memo_stack_solve(DpTopDown<Spec>{spec}, root, memo);
+}
+
+template<typename Spec, typename Memo>
+DpValue<Spec> dp_memo(const Spec &spec, const typename Spec::key_type &root, Memo &memo)
+{
+    return memo_stack_solve(DpTopDown<Spec>{spec}, root, memo);
+}
+
+template<typename Spec>
+DpValue<Spec> dp_memo(const Spec &spec, const typename Spec::key_type &root)
+{
+    auto memo = dp_storage(spec, root);
+    return dp_memo(spec, root, memo);
+}
+//
+// DP BOTTOM UP
+//
+// every state between the goals and the root, children before parents
+// pull: a state reads its children, transitions fold in the same order as top down
+// push: a finished state adds itself to its parents, nothing is pushed from a zero state,
+// so the reachable part sets the cost; the folds into a parent come in key order, the
+// same answer for DpOr and DpCount, DpMinLength may pick another path among the
+// shortest and DpEnumerate lists the paths in another order
+// specs without parent() are always pulled
+template<DenseDpSpec Spec>
+DpValue<Spec> dp_tab(const Spec &spec, const typename Spec::key_type &root, const DpOrder order = DpOrder::pull)
+{
+    using Key = typename Spec::key_type;
+    using Value = DpValue<Spec>;
+    // a struct so that bool doesn't become std::vector<bool>
+    struct Cell
+    {
+        Value value;
+    };
+    DP_STATS_CALL();
+    const typename Spec::combine_type combine{};
+    const std::size_t bound = spec.bound(root);
+    std::vector<Cell> table(bound, Cell{ combine.zero() });
+    DP_STATS_BYTES(bound * sizeof(Cell));
+    const bool down = Spec::direction == DpDirection::down;
+    // children before parents: up from 0 to root, or down from the last key to root
+    const std::size_t first = down ? 0 : bound - 1;
+    const std::size_t last = static_cast<std::size_t>(root);
+    const auto in_range = [&](const Key key){
+        return down ? static_cast<std::size_t>(key) <= last
+                    : static_cast<std::size_t>(key) >= last && static_cast<std::size_t>(key) < bound;
+    };
+
+    for(std::size_t i = first;; down ? ++i : --i){
+        const Key key = static_cast<Key>(i);
+        Value &value = table[i].value;
+        DP_STATS_CELLS(1);
+        if(spec.goal(key)) value = combine.one();
+        else if(order == DpOrder::pull || !PushDpSpec<Spec>){
+            Key child;
+            for(std::size_t k = 0; k < spec.transitions(key) && !combine.saturated(value); ++k)
+                if(spec.child(key, k, child) && in_range(child))
+                    combine.fold(value, table[static_cast<std::size_t>(child)].value, spec.label(key, k));
+        }
+        if constexpr(PushDpSpec<Spec>){
+            Key parent;
+            if(order == DpOrder::push && !combine.is_zero(value)){
+                for(std::size_t k = 0; k < spec.transitions(key); ++k){
+                    if(!spec.parent(key, k, parent) || !in_range(parent) || spec.goal(parent)) continue;
+                    Value &into = table[static_cast<std::size_t>(parent)].value;
+                    if(!combine.saturated(into)) combine.fold(into, value, spec.label(parent, k));
+                }
+            }
+        }
+        if(i == last) break;
+    }
+    return std::move(table[last].value);
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+//
+// GENERATOR
+//
+// lazy sequence from a c++20 coroutine, values are yielded by reference and stay
+// valid until the generator is resumed, breaking out of a loop over it stops it early
+template<typename T>
+class Generator
+{
+public:
+    using value_type = std::remove_cvref_t<T>;
+
+    struct promise_type
+    {
+        const value_type *current = nullptr;
+        std::exception_ptr error;
+
+        Generator get_return_object() { return Generator(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(const value_type &value) noexcept
+        {
+            current = std::addressof(value);
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    class iterator
+    {
+    public:
+        using value_type = Generator::value_type;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+        const value_type& operator*() const { return *handle_.promise().current; }
+        const value_type* operator->() const { return handle_.promise().current; }
+        iterator& operator++()
+        {
+            resume(handle_);
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        bool operator==(std::default_sentinel_t) const { return !handle_ || handle_.done(); }
+
+    private:
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    Generator(Generator &&other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Generator& operator=(Generator &&other) noexcept
+    {
+        if(this != &other){
+            if(handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+    ~Generator()
+    {
+        if(handle_) handle_.destroy();
+    }
+
+    iterator begin()
+    {
+        resume(handle_);
+        return iterator(handle_);
+    }
+    std::default_sentinel_t end() const { return {}; }
+
+    // pull style, false once the sequence is exhausted
+    bool next()
+    {
+        resume(handle_);
+        return !handle_.done();
+    }
+    const value_type& value() const { return *handle_.promise().current; }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+
+    explicit Generator(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    static void resume(std::coroutine_handle<promise_type> handle)
+    {
+        if(!handle || handle.done()) return;
+        handle.resume();
+        if(handle.promise().error) std::rethrow_exception(std::exchange(handle.promise().error, {}));
+    }
+};
+
+// copies out at most k of the remaining values
+template<typename T>
+std::vector<typename Generator<T>::value_type> take(Generator<T> &gen, const std::size_t k)
+{
+    std::vector<typename Generator<T>::value_type> result;
+    while(result.size() < k && gen.next())
+        result.push_back(gen.value());
+    return result;
+}
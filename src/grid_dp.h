@@ -0,0 +1,144 @@
+#pragma once
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "thread_pool.h"
+//
+// TILED GRID
+//
+// per cell weights of a grid traveled right and down from the top left corner,
+// stored tile by tile so a tile is one contiguous block of memory
+// a wall is a cell no path goes through
+class TiledGrid
+{
+public:
+    static constexpr int tile = 64;
+    static constexpr int wall = INT_MIN;
+
+    TiledGrid(const int rows, const int cols, const int weight = 0)
+        : rows_(rows), cols_(cols), tile_rows_((rows + tile - 1) / tile), tile_cols_((cols + tile - 1) / tile),
+          cells_(static_cast<std::size_t>(tile_rows_) * tile_cols_ * tile * tile, weight) {}
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    int tile_rows() const { return tile_rows_; }
+    int tile_cols() const { return tile_cols_; }
+
+    int& at(const int r, const int c) { return cells_[index(r, c)]; }
+    int at(const int r, const int c) const { return cells_[index(r, c)]; }
+    void block(const int r, const int c) { at(r, c) = wall; }
+    bool blocked(const int r, const int c) const { return at(r, c) == wall; }
+
+    // tile * tile cells of tile (tr, tc) row by row, cells past the grid edge are padding
+    const int* tile_data(const int tr, const int tc) const
+    {
+        return cells_.data() + (static_cast<std::size_t>(tr) * tile_cols_ + tc) * tile * tile;
+    }
+
+private:
+    int rows_, cols_, tile_rows_, tile_cols_;
+    std::vector<int> cells_;
+
+    std::size_t index(const int r, const int c) const
+    {
+        return (static_cast<std::size_t>(r / tile) * tile_cols_ + c / tile) * tile * tile + (r % tile) * tile + c % tile;
+    }
+};
+//
+// GRID OPERATIONS
+//
+// what a cell holds given the cells above and to the left, an operation provides
+//     value_type
+//     value_type none() const                     walls and the outside of the grid
+//     value_type seed() const                     an imaginary cell left of the origin
+//     value_type step(up, left, weight) const
+template<typename Count>
+struct GridPathCount
+{
+    using value_type = Count;
+    Count none() const { return Count(0); }
+    Count seed() const { return Count(1); }
+    Count step(Count up, const Count &left, int) const { up += left; return up; }
+};
+
+struct GridMinCost
+{
+    using value_type = long long;
+    static constexpr long long unreachable = std::numeric_limits<long long>::max();
+    long long none() const { return unreachable; }
+    long long seed() const { return 0; }
+    long long step(const long long up, const long long left, const int weight) const
+    {
+        const long long best = std::min(up, left);
+        return best == unreachable ? unreachable : best + weight;
+    }
+};
+
+struct GridMaxReward
+{
+    using value_type = long long;
+    static constexpr long long unreachable = std::numeric_limits<long long>::min();
+    long long none() const { return unreachable; }
+    long long seed() const { return 0; }
+    long long step(const long long up, const long long left, const int weight) const
+    {
+        const long long best = std::max(up, left);
+        return best == unreachable ? unreachable : best + weight;
+    }
+};
+//
+// GRID WAVEFRONT
+//
+// tiles on one anti-diagonal only read the tiles above and to the left, which are on the
+// previous one, so the diagonals go one after another and the tiles of each in parallel
+// a tile reads the row above it and the column left of it and overwrites both with its
+// own last row and column, the next tiles to read those spans are the ones below and
+// to the right, so one row and one column for the whole grid is all the state there is
+template<typename Op>
+void grid_fill_tile(const TiledGrid &grid, const Op &op, const int tr, const int tc,
+                    typename Op::value_type *above, typename Op::value_type *left)
+{
+    const int h = std::min(TiledGrid::tile, grid.rows() - tr * TiledGrid::tile);
+    const int w = std::min(TiledGrid::tile, grid.cols() - tc * TiledGrid::tile);
+    const int *cells = grid.tile_data(tr, tc);
+    for(int r = 0; r < h; ++r){
+        typename Op::value_type from_left = left[r];
+        const int *row = cells + r * TiledGrid::tile;
+        for(int c = 0; c < w; ++c){
+            from_left = row[c] == TiledGrid::wall ? op.none() : op.step(above[c], from_left, row[c]);
+            above[c] = from_left;
+        }
+        left[r] = from_left;
+    }
+}
+
+template<typename Op>
+typename Op::value_type grid_wavefront(const TiledGrid &grid, const Op &op, ThreadPool *pool = nullptr)
+{
+    // O(rows * cols) time, over the threads once the diagonals are wide
+    // O(rows + cols) space
+    using Value = typename Op::value_type;
+    if(grid.rows() <= 0 || grid.cols() <= 0) return op.none();
+    std::vector<Value> row(grid.cols(), op.none());
+    std::vector<Value> col(grid.rows(), op.none());
+    col[0] = op.seed();
+
+    const int tiles_r = grid.tile_rows(), tiles_c = grid.tile_cols();
+    for(int d = 0; d < tiles_r + tiles_c - 1; ++d){
+        const int first = std::max(0, d - tiles_c + 1);
+        const int last = std::min(d, tiles_r - 1);
+        auto fill = [&](const std::size_t begin, const std::size_t end){
+            for(std::size_t k = begin; k < end; ++k){
+                const int tr = first + static_cast<int>(k), tc = d - tr;
+                grid_fill_tile(grid, op, tr, tc, row.data() + tc * TiledGrid::tile, col.data() + tr * TiledGrid::tile);
+            }
+        };
+        const std::size_t tiles = last - first + 1;
+        if(pool && tiles > 1) pool->for_each_chunk(tiles, 1, fill);
+        else fill(0, tiles);
+    }
+    return row[grid.cols() - 1];
+}
@@ -1,9 +1,34 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iostream>
 #include <iomanip>
 #include <map>
+#include <memory_resource>
+#include <numeric>
+#include <optional>
+#include <span>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include "printv.h"
+#include "arena.h"
+#include "bigint.h"
+#include "count_sum.h"
+#include "count_types.h"
+#include "dp_spec.h"
+#include "generator.h"
+#include "grid_dp.h"
+#include "memo.h"
+#include "memo_stack.h"
+#include "mod_arith.h"
+#include "min_count.h"
+#include "reach_bits.h"
+#include "solver.h"
+#include "stats.h"
+#include "thread_pool.h"
+#include "word_index.h"
 
 
 //
@@ -54,37 +79,85 @@ unsigned long long int fib_recu(const int &n)
 {
     // O(2^n) time
     // O(n) space
+    DP_STATS_CALL();
     if(n <= 2) return 1;
     return fib_recu(n - 1) + fib_recu(n - 2);
 }
 //
 // FIBONACCI MEMOIZATION
 //
-unsigned long long int fib_memo(const int &n, std::map<int, long long int>& memo)
+template<typename Memo>
+unsigned long long int fib_memo(const int &n, Memo &memo)
 {
     // O(n) time
     // O(n) space
-    if(memo.count(n)) return memo[n];
+    DP_STATS_CALL();
     if(n <= 2) return 1;
-    memo[n] = fib_memo(n - 1, memo) + fib_memo(n - 2, memo);
-    return memo[n];
+    if(const auto *hit = memo.find(n)) return *hit;
+    return memo.store(n, fib_memo(n - 1, memo) + fib_memo(n - 2, memo));
 }
 
 unsigned long long int fib_memo(const int &n)
 {
-    std::map<int, long long int> memo;
+    DenseMemo<unsigned long long int> memo(n + 1);
     return fib_memo(n, memo);
 }
 //
+// FIBONACCI EXPLICIT STACK
+//
+// fib_memo on a heap stack, see memo_stack.h, n in the millions doesn't overflow the thread stack
+struct FibStack
+{
+    using key_type = int;
+    using value_type = unsigned long long int;
+    using state_type = unsigned long long int;
+
+    bool base(const int n, unsigned long long int &out) const
+    {
+        out = 1;
+        return n <= 2;
+    }
+    unsigned long long int start(int) const { return 0; }
+    std::size_t transitions(int) const { return 2; }
+    bool child(const int n, const std::size_t k, int &out) const
+    {
+        out = n - 1 - static_cast<int>(k);
+        return true;
+    }
+    bool fold(int, std::size_t, unsigned long long int &sum, const unsigned long long int child) const
+    {
+        sum += child;
+        return true;
+    }
+    unsigned long long int finish(int, unsigned long long int &&sum) const { return sum; }
+};
+
+template<typename Memo>
+unsigned long long int fib_stack(const int &n, Memo &memo)
+{
+    // O(n) time
+    // O(n) space, heap only
+    return memo_stack_solve(FibStack{}, n, memo);
+}
+
+unsigned long long int fib_stack(const int &n)
+{
+    DenseMemo<unsigned long long int> memo(n + 1);
+    return fib_stack(n, memo);
+}
+//
 // FIBONACCI TABULATION
 //
 unsigned long long int fib_tab(const int &n)
 {
     // time O(n)
     // space O(n)
+    DP_STATS_CALL();
     std::vector<long long int> table(n + 1, 0);
+    DP_STATS_BYTES(table.size() * sizeof(long long int));
     table[1] = 1;
     for(int i = 0; i < table.size() - 2; ++i){
+        DP_STATS_CELLS(2);
         table[i + 1] += table[i];
         table[i + 2] += table[i];
     }
@@ -92,9 +165,90 @@ unsigned long long int fib_tab(const int &n)
     return table[n];
 }
 //
+// FIBONACCI FAST DOUBLING
+//
+// F(2k)   = F(k) * (2 * F(k + 1) - F(k))
+// F(2k+1) = F(k)^2 + F(k + 1)^2
+unsigned long long int fib_doubling(const int &n)
+{
+    // O(log n) time
+    // O(1) space
+    unsigned long long int a = 0, b = 1;    // F(k), F(k + 1)
+    for(int bit = 31; bit >= 0; --bit){
+        const unsigned long long int c = a * (2 * b - a);
+        const unsigned long long int d = a * a + b * b;
+        if((n >> bit) & 1){
+            a = d;
+            b = c + d;
+        }
+        else{
+            a = c;
+            b = d;
+        }
+    }
+    return a;
+}
+
+BigUint fib_big(const int &n)
+{
+    // O(M(n) log n) time, M(n) is the karatsuba multiplication of n bits
+    // O(n) space
+    BigUint a = 0, b = 1;    // F(k), F(k + 1)
+    for(int bit = 31; bit >= 0; --bit){
+        if(a.is_zero() && !((n >> bit) & 1)) continue;
+        BigUint c = a * (b + b - a);
+        BigUint d = a * a + b * b;
+        if((n >> bit) & 1){
+            a = std::move(d);
+            b = a + c;
+        }
+        else{
+            a = std::move(c);
+            b = std::move(d);
+        }
+    }
+    return a;
+}
+//
+// FIBONACCI LOOKUP TABLE
+//
+// fib(93) is the last value that fits in 64 bits, the whole domain is built at compile time
+constexpr std::array<unsigned long long int, 94> make_fib_table()
+{
+    std::array<unsigned long long int, 94> table{};
+    table[1] = 1;
+    for(std::size_t i = 2; i < table.size(); ++i)
+        table[i] = table[i - 1] + table[i - 2];
+    return table;
+}
+
+constexpr std::array<unsigned long long int, 94> fib_table = make_fib_table();
+static_assert(fib_table[50] == 12'586'269'025);
+static_assert(fib_table[93] == 12'200'160'415'121'876'738ull);
+
+template<int N>
+constexpr unsigned long long int fib_ct()
+{
+    static_assert(N >= 0 && N < 94, "fib_ct index out of the 64 bit domain");
+    return fib_table[N];
+}
+
+unsigned long long int fib_lookup(const int &n)
+{
+    // O(1) time, O(log n) past the table
+    // O(1) space
+    if(n >= 0 && n < static_cast<int>(fib_table.size())) return fib_table[n];
+    return fib_doubling(n);
+}
+//
 // FIBONACCI CALLER
 //
-unsigned long long int fib(const int &n, unsigned long long int(*fib_fun)(const int&) = fib_tab)
+// the callers come in two forms: templates taking any callable, instantiated once per
+// solver<...> tag so the variant is inlined, and pointer shims for variants picked at runtime
+using FibFunc = unsigned long long int(*)(const int&);
+
+template<SolverFor<unsigned long long int, const int&> F>
+unsigned long long int fib(const int &n, F fib_fun)
 {
     // max number 12,200,160,415,121,876,738
     if(n > 93) std::clog << "Number > 93, FIB OVERFLOW!" << std::endl;
@@ -107,14 +261,301 @@ unsigned long long int fib(const int &n, unsigned long long int(*fib_fun)(const
     return fib_fun(n);  // callback fib algorithm
 }
 
+unsigned long long int fib(const int &n, FibFunc fib_fun = fib_lookup)
+{
+    return fib<FibFunc>(n, fib_fun);
+}
+
+// arbitrary precision overload, no overflow past 93
+BigUint fib(const int &n, BigUint(*fib_fun)(const int&))
+{
+    if(n < 0){
+        std::clog << "Negative number! Invalid." << std::endl;
+        return 0;
+    }
+    return fib_fun(n);
+}
+
 void test_fib(unsigned long long int(*fib_fun)(const int&) = fib_tab)
 {
-    std::map<int, long long int> memo;
     std::cout << fib(6, fib_fun) << '\n';    // 8
     std::cout << fib(7, fib_fun) << '\n';    // 13
     std::cout << fib(8, fib_fun) << '\n';    // 21
     std::cout << fib(50, fib_fun) << '\n';   // 12'586'269'025
 }
+
+void test_fib_big(BigUint(*fib_fun)(const int&) = fib_big)
+{
+    std::cout << fib(8, fib_fun) << '\n';       // 21
+    std::cout << fib(93, fib_fun) << '\n';      // 12'200'160'415'121'876'738
+    std::cout << fib(100, fib_fun) << '\n';     // 354'224'848'179'261'915'075
+    std::cout << fib(1'000'000, fib_fun).to_string().size() << '\n';  // 208'988 digits
+}
+//
+// FIBONACCI MOD
+//
+// F(n) mod m for n past any int, up to 128 bits, by fast doubling in whichever ring of
+// mod_arith.h fits m: barrett below 2^32, montgomery for wider odd m, and a wide even m
+// split into 2^k * q, each part done on its own and put back together by the crt
+// several chains run in lockstep so their multiplies overlap in the pipeline
+template<std::size_t Lanes, typename Ring>
+void fib_mod_lanes(const Ring &ring, const uint128 *n, std::uint64_t *out)
+{
+    // O(log n) time
+    // O(1) space
+    std::uint64_t a[Lanes], b[Lanes];    // F(k), F(k + 1), in the ring's form
+    uint128 bits = 0;
+    for(std::size_t k = 0; k < Lanes; ++k){
+        a[k] = ring.in(0);
+        b[k] = ring.in(1);
+        bits |= n[k];
+    }
+    // a shorter n sees leading zero bits first, which keep F(0), F(1) as they are
+    // the high word, then the low one, a 64 bit shift per step instead of a 128 bit one
+    const int width = bit_width_128(bits);
+    for(int word = width > 64 ? 1 : 0; word >= 0; --word){
+        std::uint64_t w[Lanes];
+        for(std::size_t k = 0; k < Lanes; ++k) w[k] = static_cast<std::uint64_t>(n[k] >> (64 * word));
+        for(int bit = word ? width - 65 : std::min(width, 64) - 1; bit >= 0; --bit){
+            for(std::size_t k = 0; k < Lanes; ++k){
+                const std::uint64_t c = ring.mul(a[k], ring.sub(ring.add(b[k], b[k]), a[k]));
+                const std::uint64_t d = ring.add(ring.mul(a[k], a[k]), ring.mul(b[k], b[k]));
+                // n's bits are random, a mask instead of a branch that mispredicts half the time
+                const std::uint64_t take = std::uint64_t(0) - ((w[k] >> bit) & 1);
+                a[k] = c ^ ((c ^ d) & take);
+                b[k] = d ^ ((d ^ ring.add(c, d)) & take);
+            }
+        }
+    }
+    for(std::size_t k = 0; k < Lanes; ++k) out[k] = ring.out(a[k]);
+}
+
+// the reduction set up once for a modulus, then any number of n
+class FibModulus
+{
+public:
+    explicit FibModulus(const std::uint64_t m) : m_(m)
+    {
+        if(m < (std::uint64_t(1) << 32)){
+            kind_ = Kind::barrett;
+            barrett_ = BarrettMod(m);
+            return;
+        }
+        const int k = std::countr_zero(m);
+        const std::uint64_t q = m >> k;
+        if(k) power_ = PowerOfTwoMod(k);
+        if(q > 1) montgomery_ = MontgomeryMod(q);
+        kind_ = !k ? Kind::montgomery : q == 1 ? Kind::power_of_two : Kind::split;
+        // q^-1 mod 2^k, newton like MontgomeryMod's
+        q_inverse_ = q;
+        for(int step = 0; step < 5; ++step) q_inverse_ *= 2 - q * q_inverse_;
+    }
+
+    std::uint64_t modulus() const { return m_; }
+
+    template<std::size_t Lanes>
+    void evaluate(const uint128 *n, std::uint64_t *out) const
+    {
+        switch(kind_){
+        case Kind::barrett: fib_mod_lanes<Lanes>(barrett_, n, out); return;
+        case Kind::montgomery: fib_mod_lanes<Lanes>(montgomery_, n, out); return;
+        case Kind::power_of_two: fib_mod_lanes<Lanes>(power_, n, out); return;
+        case Kind::split:
+            // x = odd part + q * ((2^k part - odd part) * q^-1 mod 2^k)
+            std::uint64_t low[Lanes];
+            fib_mod_lanes<Lanes>(power_, n, low);
+            fib_mod_lanes<Lanes>(montgomery_, n, out);
+            for(std::size_t k = 0; k < Lanes; ++k)
+                out[k] += montgomery_.m * (((low[k] - out[k]) * q_inverse_) & power_.mask);
+            return;
+        }
+    }
+
+    std::uint64_t operator()(const uint128 n) const
+    {
+        std::uint64_t result = 0;
+        evaluate<1>(&n, &result);
+        return result;
+    }
+
+private:
+    enum class Kind { barrett, montgomery, power_of_two, split };
+    std::uint64_t m_;
+    Kind kind_ = Kind::barrett;
+    BarrettMod barrett_;
+    MontgomeryMod montgomery_;
+    PowerOfTwoMod power_;
+    std::uint64_t q_inverse_ = 1;
+};
+
+// pisano periods: F mod m repeats with period pi(m), so n can drop to n mod pi(m) < 6m
+// first, 128 bit n take 128 doubling steps but n mod pi(m) only about log2(6m)
+// pi(m) is the lcm of pi(p^e) over the prime powers of m, pi(p^e) = p^(e - 1) pi(p) is at
+// least a multiple of it, which is all the reduction needs, and pi(p) divides p - 1 when
+// p = 1, 4 mod 5 and 2(p + 1) when p = 2, 3 mod 5, the smallest divisor with
+// F(d) = 0, F(d + 1) = 1 mod p is it
+// a period is worked out once per modulus, factoring included, later lookups are a hash
+class PisanoCache
+{
+public:
+    // moduli above this aren't cached, 2(p + 1) still fits in 64 bits below it
+    static constexpr std::uint64_t max_modulus = std::uint64_t(1) << 62;
+
+    // a period of F mod m, 0 when m is too wide or the period doesn't fit in 64 bits
+    std::uint64_t period(const std::uint64_t m)
+    {
+        if(const auto it = periods_.find(m); it != periods_.end()) return it->second;
+        return periods_[m] = compute(m);
+    }
+
+    std::size_t size() const { return periods_.size(); }
+
+private:
+    std::unordered_map<std::uint64_t, std::uint64_t> periods_;
+
+    static std::uint64_t prime_period(const std::uint64_t p)
+    {
+        if(p == 2) return 3;
+        if(p == 5) return 20;
+        std::uint64_t d = (p % 5 == 1 || p % 5 == 4) ? p - 1 : 2 * (p + 1);
+        const FibModulus mod(p);
+        for(const std::pair<std::uint64_t, int> &factor : factorize(d)){
+            while(d % factor.first == 0){
+                const uint128 n[2] = { d / factor.first, d / factor.first + 1 };
+                std::uint64_t f[2] = {};
+                mod.evaluate<2>(n, f);
+                if(f[0] != 0 || f[1] != 1) break;
+                d /= factor.first;
+            }
+        }
+        return d;
+    }
+
+    static std::uint64_t compute(const std::uint64_t m)
+    {
+        if(m == 1) return 1;
+        if(m > max_modulus) return 0;
+        uint128 period = 1;
+        for(const auto &[p, e] : factorize(m)){
+            uint128 part = prime_period(p);
+            for(int k = 1; k < e; ++k) part *= p;
+            // both below 2^64, part is at most about 3m
+            period = period / std::gcd(static_cast<std::uint64_t>(period), static_cast<std::uint64_t>(part)) * part;
+            if(period >> 64) return 0;
+        }
+        return static_cast<std::uint64_t>(period);
+    }
+};
+
+std::uint64_t fib_mod(const uint128 n, const std::uint64_t m)
+{
+    DP_STATS_CALL();
+    if(m == 0){
+        std::clog << "Modulus 0! Invalid." << std::endl;
+        return 0;
+    }
+    return FibModulus(m)(n);
+}
+
+// repeated moduli: n first drops below the cached period
+std::uint64_t fib_mod(const uint128 n, const std::uint64_t m, PisanoCache &cache)
+{
+    if(m == 0) return fib_mod(n, m);
+    const std::uint64_t period = cache.period(m);
+    return fib_mod(period ? n % period : n, m);
+}
+
+// plain integer n, signed ones checked, so fib_mod(10, 7) isn't ambiguous
+template<std::integral N>
+std::uint64_t fib_mod(const N n, const std::uint64_t m)
+{
+    if(n < 0){
+        std::clog << "Negative number! Invalid." << std::endl;
+        return 0;
+    }
+    return fib_mod(static_cast<uint128>(n), m);
+}
+
+struct FibModQuery
+{
+    uint128 n;
+    std::uint64_t m;
+};
+
+// many (n, m) at once: grouped by modulus, each modulus is set up once and its queries
+// go through eight chains at a time, with a cache every n drops below its period first
+std::vector<std::uint64_t> fib_mod_batch(const std::span<const FibModQuery> queries, PisanoCache *cache = nullptr)
+{
+    // O(q log n) time
+    // O(q) space
+    DP_STATS_CALL();
+    constexpr std::size_t lanes = 8;
+    std::vector<std::uint64_t> result(queries.size(), 0);
+    // grouped by modulus with a counting sort, one pass numbers the moduli, one places
+    // the indices, a few moduli among many queries is the usual shape
+    std::unordered_map<std::uint64_t, std::uint32_t> ids;
+    std::vector<std::uint64_t> moduli;
+    std::vector<std::uint32_t> id(queries.size());
+    for(std::size_t i = 0; i < queries.size(); ++i){
+        const auto [it, fresh] = ids.try_emplace(queries[i].m, static_cast<std::uint32_t>(moduli.size()));
+        if(fresh) moduli.push_back(queries[i].m);
+        id[i] = it->second;
+    }
+    std::vector<std::size_t> start(moduli.size() + 1, 0);
+    for(const std::uint32_t g : id) ++start[g + 1];
+    std::partial_sum(start.begin(), start.end(), start.begin());
+    std::vector<std::uint32_t> order(queries.size());
+    std::vector<std::size_t> fill(start.begin(), start.end() - 1);
+    for(std::size_t i = 0; i < queries.size(); ++i) order[fill[id[i]]++] = static_cast<std::uint32_t>(i);
+
+    for(std::size_t g = 0; g < moduli.size(); ++g){
+        const std::uint64_t m = moduli[g];
+        const std::size_t begin = start[g], end = start[g + 1];
+        if(m == 0){
+            std::clog << "Modulus 0! Invalid." << std::endl;
+            continue;
+        }
+        const FibModulus mod(m);
+        const std::uint64_t period = cache ? cache->period(m) : 0;
+        std::size_t i = begin;
+        for(; i + lanes <= end; i += lanes){
+            uint128 n[lanes];
+            for(std::size_t k = 0; k < lanes; ++k){
+                n[k] = queries[order[i + k]].n;
+                if(period) n[k] %= period;
+            }
+            std::uint64_t f[lanes];
+            mod.evaluate<lanes>(n, f);
+            for(std::size_t k = 0; k < lanes; ++k) result[order[i + k]] = f[k];
+        }
+        // the rest one chain each, idle lanes would cost as much as busy ones
+        for(; i < end; ++i){
+            const uint128 n = queries[order[i]].n;
+            result[order[i]] = mod(period ? n % period : n);
+        }
+    }
+    return result;
+}
+
+void test_fib_mod()
+{
+    std::cout << fib_mod(10, 7) << '\n';    // 55 mod 7 = 6
+    std::cout << fib_mod(100, 1'000'000'007) << '\n';    // 687'995'182
+    std::cout << fib_mod(std::uint64_t(1) << 63, 1'000'000'007) << '\n';    // 814'278'197
+    // a montgomery modulus, an even one past 32 bits, and a power of two
+    std::cout << fib_mod(1'000'000'000'000'000'000ull, 18'446'744'073'709'551'557ull) << '\n';    // 7'905'894'408'451'582'888
+    std::cout << fib_mod(1'000'000'000'000'000'000ull, 1'000'000'000'000ull) << '\n';    // 299'560'546'875
+    std::cout << fib_mod(1'000'000'000'000'000'000ull, std::uint64_t(1) << 40) << '\n';    // 745'463'214'651
+    
+    // 128 bit n, 2^100
+    const uint128 huge = static_cast<uint128>(1) << 100;
+    PisanoCache cache;
+    std::cout << fib_mod(huge, 1'000'000'007) << ' ' << fib_mod(huge, 1'000'000'007, cache) << '\n';    // 931'794'721 931'794'721
+    std::cout << cache.period(1'000'000'007) << ' ' << cache.period(10) << ' ' << cache.period(1'000) << '\n';   // 2'000'000'016 60 1'500
+    
+    std::vector<FibModQuery> queries = { { 10, 7 }, { huge, 1'000'000'007 }, { 100, 1'000'000'007 }, { 61, 10 } };
+    printv(fib_mod_batch(queries, &cache));    // {6, 931'794'721, 687'995'182, 1}
+}
 //
 // GRID TRAVELER RECURSION
 //
@@ -122,6 +563,7 @@ unsigned int grid_traveler_recu(const int &x, const int &y)
 {
     // O(2 ^ y+x) time
     // O(y+x) space
+    DP_STATS_CALL();
     if (x == 1 && y == 1) return 1;
     if (x == 0 || y == 0) return 0;
     return grid_traveler_recu(x - 1, y) + grid_traveler_recu(x, y - 1);
@@ -129,22 +571,23 @@ unsigned int grid_traveler_recu(const int &x, const int &y)
 //
 // GRID TRAVELER MEMOIZATION
 //
-unsigned int grid_traveler_memo(const int &x, const int &y, std::map<std::vector<int>, long long int>& memo)
+template<typename Memo>
+unsigned int grid_traveler_memo(const int &x, const int &y, Memo &memo)
 {
     // O(x * y) time
     // O(y + x) space
-    const std::vector<int> key = { x, y };
-    if (memo.count(key)) return memo[key];
+    DP_STATS_CALL();
     if (x == 1 && y == 1) return 1;
     if (x == 0 || y == 0) return 0;
-    memo[key] = grid_traveler_memo(x - 1, y, memo) + grid_traveler_memo(x, y - 1, memo);
-    return memo[key];
+    const std::uint64_t key = pack_key(x, y);
+    if(const auto *hit = memo.find(key)) return *hit;
+    return memo.store(key, grid_traveler_memo(x - 1, y, memo) + grid_traveler_memo(x, y - 1, memo));
 }
 
 // overload
 unsigned int grid_traveler_memo(const int &x, const int &y)
 {
-    std::map<std::vector<int>, long long int> memo;
+    FlatHashMemo<std::uint64_t, unsigned int> memo(static_cast<std::size_t>(std::max(x, 0)) * std::max(y, 0));
     return grid_traveler_memo(x, y, memo);
 }
 //
@@ -154,10 +597,13 @@ unsigned int grid_traveler_tab(const int &x, const int &y)
 {
     // O(n*m) time
     // O(n*m) space
+    DP_STATS_CALL();
     std::vector<std::vector<int>> table(x+1, std::vector<int>(y+1, 0));
+    DP_STATS_BYTES((x + 1) * (y + 1) * sizeof(int));
     table[1][1] = 1;
     for(int i = 0; i <= x; ++i){
         for(int j = 0; j <= y; ++j){
+            DP_STATS_CELLS(1);
             const int current = table[i][j];
             if(j+1 <= y) table[i][j + 1] += current;
             if(i+1 <= x) table[i + 1][j] += current;
@@ -166,9 +612,144 @@ unsigned int grid_traveler_tab(const int &x, const int &y)
     return table[x][y];
 }
 //
+// GRID TRAVELER ROLLING ROW
+//
+template<typename T = unsigned int>
+T grid_traveler_roll(const int &x, const int &y)
+{
+    // O(x * y) time
+    // O(min(x, y)) space
+    if(x <= 0 || y <= 0) return T(0);
+    const int width = std::min(x, y);
+    const int height = std::max(x, y);
+    std::vector<T> row(width, T(1));    // first row, a single way to reach each cell
+    for(int i = 1; i < height; ++i)
+        for(int j = 1; j < width; ++j)
+            row[j] += row[j - 1];
+    return row[width - 1];
+}
+//
+// GRID TRAVELER BINOMIAL
+//
+// a path is x - 1 downs and y - 1 rights in any order: C(x + y - 2, x - 1)
+BigUint grid_traveler_binom(const int &x, const int &y)
+{
+    // O(min(x, y) * (x + y)) time
+    // O(x + y) space
+    if(x <= 0 || y <= 0) return 0;
+    const int n = x + y - 2;
+    const int k = std::min(x, y) - 1;
+    BigUint result = 1;
+    for(int i = 1; i <= k; ++i){
+        // result stays C(n - k + i, i), so the division is exact
+        result.mul_small(n - k + i);
+        result.div_small(i);
+    }
+    return result;
+}
+
+std::uint32_t pow_mod(std::uint64_t base, std::uint64_t exp, const std::uint32_t mod)
+{
+    std::uint64_t result = 1 % mod;
+    base %= mod;
+    while(exp){
+        if(exp & 1) result = result * base % mod;
+        base = base * base % mod;
+        exp >>= 1;
+    }
+    return static_cast<std::uint32_t>(result);
+}
+
+// C(n, k) mod a prime p > n, factorial tables grow on demand and are kept between queries
+class BinomialMod
+{
+public:
+    explicit BinomialMod(const std::uint32_t p = 1'000'000'007) : p_(p), fact_{1}, inv_fact_{1} {}
+
+    std::uint32_t modulus() const { return p_; }
+
+    void reserve(const int n)
+    {
+        // O(n - cached + log p) time
+        const std::size_t old_size = fact_.size();
+        if(n < static_cast<int>(old_size)) return;
+        fact_.resize(n + 1);
+        inv_fact_.resize(n + 1);
+        for(std::size_t i = old_size; i <= static_cast<std::size_t>(n); ++i)
+            fact_[i] = static_cast<std::uint32_t>(static_cast<std::uint64_t>(fact_[i - 1]) * i % p_);
+        inv_fact_[n] = pow_mod(fact_[n], p_ - 2, p_);
+        for(std::size_t i = n; i > old_size; --i)
+            inv_fact_[i - 1] = static_cast<std::uint32_t>(static_cast<std::uint64_t>(inv_fact_[i]) * i % p_);
+    }
+
+    std::uint32_t operator()(const int n, const int k)
+    {
+        // O(1) time once the tables cover n
+        if(k < 0 || k > n) return 0;
+        reserve(n);
+        return static_cast<std::uint32_t>(static_cast<std::uint64_t>(fact_[n]) * inv_fact_[k] % p_ * inv_fact_[n - k] % p_);
+    }
+
+private:
+    std::uint32_t p_;
+    std::vector<std::uint32_t> fact_;
+    std::vector<std::uint32_t> inv_fact_;
+};
+
+unsigned int grid_traveler_mod(const int &x, const int &y, BinomialMod &binom)
+{
+    // O(1) time amortized
+    // O(x + y) space, shared by every query on binom
+    if(x <= 0 || y <= 0) return 0;
+    return binom(x + y - 2, x - 1);
+}
+
+// modulo 1'000'000'007
+unsigned int grid_traveler_mod(const int &x, const int &y)
+{
+    static BinomialMod binom;
+    return grid_traveler_mod(x, y, binom);
+}
+//
+// GRID TRAVELER LOOKUP TABLE
+//
+// 18 x 18 is the largest square grid whose every sub grid count fits in unsigned int
+constexpr int grid_table_size = 19;
+
+constexpr std::array<std::array<unsigned int, grid_table_size>, grid_table_size> make_grid_traveler_table()
+{
+    std::array<std::array<unsigned int, grid_table_size>, grid_table_size> table{};
+    for(int i = 1; i < grid_table_size; ++i)
+        for(int j = 1; j < grid_table_size; ++j)
+            table[i][j] = (i == 1 && j == 1) ? 1 : table[i - 1][j] + table[i][j - 1];
+    return table;
+}
+
+constexpr std::array<std::array<unsigned int, grid_table_size>, grid_table_size> grid_traveler_table = make_grid_traveler_table();
+static_assert(grid_traveler_table[3][3] == 6);
+static_assert(grid_traveler_table[18][18] == 2'333'606'220u);
+
+template<int X, int Y>
+constexpr unsigned int grid_traveler_ct()
+{
+    static_assert(X >= 0 && Y >= 0 && X < grid_table_size && Y < grid_table_size, "grid_traveler_ct size out of the table");
+    return grid_traveler_table[X][Y];
+}
+
+unsigned int grid_traveler_lookup(const int &x, const int &y)
+{
+    // O(1) time, falls back to tabulation past the table
+    // O(1) space
+    if(x >= 0 && y >= 0 && x < grid_table_size && y < grid_table_size) return grid_traveler_table[x][y];
+    return grid_traveler_tab(x, y);
+}
+//
 // GRID TRAVELER CALLER
 //
-unsigned int grid_traveler(const int &x, const int &y, unsigned int(*grid_traveler_func)(const int&, const int&) = grid_traveler_tab)
+using GridTravelerFunc = unsigned int(*)(const int&, const int&);
+
+template<SolverFor<unsigned int, const int&, const int&> F>
+unsigned int grid_traveler(const int &x, const int &y, F grid_traveler_func)
 {
     if(x < 0 || y < 0) std::clog << "Negative numbers are not alowed." << std::endl;
     if (x == 1 && y == 1) return 1;
@@ -176,13 +757,96 @@ unsigned int grid_traveler(const int &x, const int &y, unsigned int(*grid_travel
     return grid_traveler_func(x, y);
 }
 
+unsigned int grid_traveler(const int &x, const int &y, GridTravelerFunc grid_traveler_func = grid_traveler_lookup)
+{
+    return grid_traveler<GridTravelerFunc>(x, y, grid_traveler_func);
+}
+
+// arbitrary precision overload
+BigUint grid_traveler(const int &x, const int &y, BigUint(*grid_traveler_func)(const int&, const int&))
+{
+    if(x < 0 || y < 0){
+        std::clog << "Negative numbers are not alowed." << std::endl;
+        return 0;
+    }
+    if (x == 0 || y == 0) return 0;
+    return grid_traveler_func(x, y);
+}
+
 void test_grid_traveler(unsigned int(*grid_traveler_func)(const int&, const int&))
 {
     std::cout << grid_traveler(1, 1, grid_traveler_func) << '\n';   // 1
     std::cout << grid_traveler(2, 3, grid_traveler_func) << '\n';   // 3
     std::cout << grid_traveler(3, 2, grid_traveler_func) << '\n';   // 3
     std::cout << grid_traveler(3, 3, grid_traveler_func) << '\n';   // 6
-    std::cout << grid_traveler(18, 18, grid_traveler_func) << '\n'; // 2'333'806'220
+    std::cout << grid_traveler(18, 18, grid_traveler_func) << '\n'; // 2'333'606'220
+}
+
+void test_grid_traveler_big(BigUint(*grid_traveler_func)(const int&, const int&) = grid_traveler_binom)
+{
+    std::cout << grid_traveler(3, 3, grid_traveler_func) << '\n';     // 6
+    std::cout << grid_traveler(18, 18, grid_traveler_func) << '\n';   // 2'333'606'220
+    std::cout << grid_traveler(50, 50, grid_traveler_func) << '\n';   // 25'477'612'258'980'856'902'730'428'600
+}
+
+void test_grid_traveler_mod()
+{
+    BinomialMod binom(1'000'000'007);
+    std::cout << grid_traveler_mod(3, 3, binom) << '\n';          // 6
+    std::cout << grid_traveler_mod(18, 18, binom) << '\n';        // 333'606'206
+    std::cout << grid_traveler_mod(1'000, 1'000, binom) << '\n';  // 965'601'742
+}
+//
+// GRID TRAVELER WEIGHTED
+//
+// grid_traveler on a grid with walls and per cell weights, a pool spreads each
+// wavefront of tiles over its threads, without one the tiles go in order
+template<typename Count = unsigned int>
+Count grid_traveler_paths(const TiledGrid &grid, ThreadPool *pool = nullptr)
+{
+    // O(x * y) time
+    // O(x + y) space
+    return grid_wavefront(grid, GridPathCount<Count>{}, pool);
+}
+
+// smallest weight sum of a path, GridMinCost::unreachable when the walls cut it off
+long long grid_traveler_min_cost(const TiledGrid &grid, ThreadPool *pool = nullptr)
+{
+    // O(x * y) time
+    // O(x + y) space
+    return grid_wavefront(grid, GridMinCost{}, pool);
+}
+
+// largest weight sum of a path, GridMaxReward::unreachable when the walls cut it off
+long long grid_traveler_max_reward(const TiledGrid &grid, ThreadPool *pool = nullptr)
+{
+    // O(x * y) time
+    // O(x + y) space
+    return grid_wavefront(grid, GridMaxReward{}, pool);
+}
+
+void test_grid_traveler_weighted()
+{
+    TiledGrid open(18, 18);
+    std::cout << grid_traveler_paths(open) << '\n';    // 2'333'606'220
+    
+    TiledGrid walled(3, 3);
+    walled.block(1, 1);
+    std::cout << grid_traveler_paths(walled) << '\n';  // 2
+    walled.block(0, 2);
+    walled.block(2, 0);
+    std::cout << grid_traveler_paths(walled) << '\n';  // 0
+    
+    TiledGrid weights(3, 3);
+    const int costs[3][3] = { { 1, 3, 1 }, { 1, 5, 1 }, { 4, 2, 1 } };
+    for(int r = 0; r < 3; ++r)
+        for(int c = 0; c < 3; ++c) weights.at(r, c) = costs[r][c];
+    std::cout << grid_traveler_min_cost(weights) << '\n';     // 7
+    std::cout << grid_traveler_max_reward(weights) << '\n';   // 12
+    
+    ThreadPool pool(4);
+    TiledGrid big(1'000, 1'000);
+    std::cout << grid_traveler_paths<ModCount<>>(big, &pool) << '\n';    // 965'601'742
 }
 //
 // CAN SUM RECURSION
@@ -191,6 +855,7 @@ bool can_sum_recu(const int &target, const std::vector<int> &numbers)
 {
     // O(n ^ m) time
     // O(m) space
+    DP_STATS_CALL();
     if (target == 0) return true;
     if (target < 0) return false;
     
@@ -204,128 +869,373 @@ bool can_sum_recu(const int &target, const std::vector<int> &numbers)
 //
 // CAN SUM? MEMOIZATION
 //
-bool can_sum_memo(const int &target, const std::vector<int> &numbers, std::map<int, bool> &memo)
+template<typename Memo>
+bool can_sum_memo(const int &target, const std::vector<int> &numbers, Memo &memo)
 {
-    if (memo.count(target)) return memo[target];
+    DP_STATS_CALL();
     if (target == 0) return true;
     if (target < 0) return false;
+    if (const auto *hit = memo.find(target)) return *hit;
     
     for (int number : numbers){
         const int remainder = target - number;
         if (can_sum_memo(remainder, numbers, memo)){
-            memo[target] = true;
+            memo.store(target, true);
             return true;
         }
     }
-    memo[target] = false;
+    memo.store(target, false);
     return false;
 }
 
 // can_sum_memo overload
 bool can_sum_memo(const int &target, const std::vector<int> &numbers)
 {
-    std::map<int, bool> memo;
+    DenseMemo<bool> memo(target + 1);
     return can_sum_memo(target, numbers, memo);
 }
 //
+// CAN SUM EXPLICIT STACK
+//
+// can_sum_memo on a heap stack, negative remainders lead nowhere instead of being visited
+struct CanSumStack
+{
+    using key_type = int;
+    using value_type = bool;
+    using state_type = bool;
+
+    const std::vector<int> &numbers;
+
+    bool base(const int target, bool &out) const
+    {
+        out = true;
+        return target == 0;
+    }
+    bool start(int) const { return false; }
+    std::size_t transitions(int) const { return numbers.size(); }
+    bool child(const int target, const std::size_t k, int &out) const
+    {
+        out = target - numbers[k];
+        return out >= 0;
+    }
+    bool fold(int, std::size_t, bool &found, const bool child) const
+    {
+        found = child;
+        return !found;
+    }
+    bool finish(int, bool &&found) const { return found; }
+};
+
+template<typename Memo>
+bool can_sum_stack(const int &target, const std::vector<int> &numbers, Memo &memo)
+{
+    // O(m*n) time
+    // O(m) space, heap only
+    if(target < 0) return false;
+    return memo_stack_solve(CanSumStack{numbers}, target, memo);
+}
+
+bool can_sum_stack(const int &target, const std::vector<int> &numbers)
+{
+    DenseMemo<bool> memo(target + 1);
+    return can_sum_stack(target, numbers, memo);
+}
+//
 // CAN SUM TABULATION
 //
 bool can_sum_tab(const int &target, const std::vector<int> &numbers)
 {
     // O(m*n) time
     // O(m) space
+    DP_STATS_CALL();
     std::vector<bool> table(target+1, false);
+    DP_STATS_BYTES(table.size() / 8);
     table[0] = true;
-    for(int i = 0; i < table.size(); ++i)
+    for(int i = 0; i < table.size(); ++i){
+        DP_STATS_CELLS(1);
         if(table[i])
             for(int num : numbers)
-                if(i + num <= table.size())table[i + num] = true;
+                if(i + num < table.size())table[i + num] = true;
+    }
     return table[target];
 }
 //
-// CAN SUN CALLER
+// CAN SUM BITSET
 //
-bool can_sum(const int &target, const std::vector<int> &numbers, bool(*can_sum_func)(const int&, const std::vector<int>&) = can_sum_tab)
+bool can_sum_bits(const int &target, const std::vector<int> &numbers)
 {
-    if(target < 0){
-        std::clog << "Negative number! Invalid." << std::endl;
-        return false;
+    // O(m*n / 64) time, O(m*n / 512) with avx-512
+    // O(m / 64) space
+    std::vector<std::uint64_t> reach(target / 64 + 1, 0);
+    set_bit(reach, 0);
+    for(int num : numbers){
+        if(num <= 0 || num > target) continue;
+        unbounded_shift_or(reach, num);
+        if(test_bit(reach, target)) return true;
     }
-    else if(target == 0) return true;
-    return can_sum_func(target, numbers);
-}
-void test_can_sum(bool(*can_sum_func)(const int&, const std::vector<int>&))
-{
-    std::cout << std::boolalpha;
-    std::vector<int> numbers1 = { 2, 3 };
-    std::cout << can_sum(7, numbers1, can_sum_func) << std::endl;     // true
-    std::vector<int> numbers2 = { 5, 3, 4, 7 };
-    std::cout << can_sum(7, numbers2, can_sum_func) << std::endl;     // true
-    std::vector<int> numbers3 = { 2, 4 };
-    std::cout << can_sum(7, numbers3, can_sum_func) << std::endl;     // false
-    std::vector<int> numbers4 = { 2, 3, 5 };
-    std::cout << can_sum(8, numbers4, can_sum_func) << std::endl;     // true
-    std::vector<int> numbers5 = { 7, 14 };
-    std::cout << can_sum(300, numbers5, can_sum_func) << std::endl;   // false
+    return test_bit(reach, target);
 }
 //
-// HOW SUM RECURSION
+// COUNT SUM
 //
-std::vector<int> how_sum_recu(const int &target, const std::vector<int> &numbers)
+// the number of ways to make target, ordered counts 3 + 4 and 4 + 3 apart, unordered
+// counts them once, numbers are used any number of times and a repeated number is one
+// number, non-positive ones can't be used
+enum class SumOrder { unordered, ordered };
+
+// distinct usable numbers, ascending
+std::vector<int> count_sum_numbers(const std::vector<int> &numbers)
 {
-    // O(n ^ m * m) time
-    // O(m) space
-    if (target == 0) return {};
-    std::vector<int> null_vector = {0};
-    if (target < 0) return null_vector;
-    
-    for (int number : numbers){
-        const int remainder = target - number;
-        std::vector<int> remainder_result = how_sum_recu(remainder, numbers);
-        if (remainder_result != null_vector){
-            remainder_result.push_back(number);
-            return remainder_result;
+    std::vector<int> usable;
+    for(int num : numbers) if(num > 0) usable.push_back(num);
+    std::sort(usable.begin(), usable.end());
+    usable.erase(std::unique(usable.begin(), usable.end()), usable.end());
+    return usable;
+}
+
+template<typename Count>
+Count count_sum_as(const int &target, const std::vector<int> &numbers, const SumOrder order)
+{
+    // time O(m*n) additions of Count
+    // space O(m)
+    DP_STATS_CALL();
+    if(target < 0) return Count(0);
+    const std::vector<int> usable = count_sum_numbers(numbers);
+    std::vector<Count> table(target + 1, Count(0));
+    DP_STATS_BYTES(table.size() * sizeof(Count));
+    table[0] = Count(1);
+    if(order == SumOrder::unordered){
+        // a number at a time, ways up to i with the numbers so far
+        for(int num : usable){
+            for(int i = num; i <= target; ++i){
+                DP_STATS_CELLS(1);
+                table[i] += table[i - num];
+            }
         }
     }
-    return null_vector;
+    else{
+        // ways to i ending in each number
+        for(int i = 1; i <= target; ++i){
+            DP_STATS_CELLS(1);
+            for(int num : usable){
+                if(num > i) break;
+                table[i] += table[i - num];
+            }
+        }
+    }
+    return table[target];
+}
+
+template<SumOrder Order = SumOrder::unordered>
+BigUint count_sum_big(const int &target, const std::vector<int> &numbers)
+{
+    return count_sum_as<BigUint>(target, numbers, Order);
+}
+
+template<SumOrder Order = SumOrder::unordered>
+CheckedCount count_sum_checked(const int &target, const std::vector<int> &numbers)
+{
+    return count_sum_as<CheckedCount>(target, numbers, Order);
+}
+
+// raw residues through the add mod kernel a block at a time, ModCount is only the result type
+template<SumOrder Order = SumOrder::unordered, std::uint32_t P = 1'000'000'007>
+ModCount<P> count_sum_mod(const int &target, const std::vector<int> &numbers)
+{
+    // O(m*n) time, a vector at a time
+    // O(block + sum of the numbers) space, not O(m)
+    DP_STATS_CALL();
+    if(target < 0) return 0;
+    const std::vector<int> usable = count_sum_numbers(numbers);
+    DP_STATS_CELLS(static_cast<std::uint64_t>(target + 1) * usable.size());
+    ModCount<P> result;
+    result.value = Order == SumOrder::unordered ? count_sum_unordered_mod(target, usable, P)
+                                                : count_sum_ordered_mod(target, usable, P);
+    return result;
+}
+//
+// COUNT SUM CALLER
+//
+template<typename F, typename Count = std::invoke_result_t<const F&, const int&, const std::vector<int>&>>
+    requires SolverFor<F, Count, const int&, const std::vector<int>&>
+Count count_sum(const int &target, const std::vector<int> &numbers, F count_sum_func)
+{
+    if(target < 0){
+        std::clog << "Negative number! Invalid." << std::endl;
+        return Count(0);
+    }
+    return count_sum_func(target, numbers);
+}
+
+void test_count_sum()
+{
+    std::vector<int> numbers1 = { 1, 2, 5 };
+    std::cout << count_sum(11, numbers1, count_sum_checked<>) << '\n';    // 11
+    std::cout << count_sum(11, numbers1, count_sum_checked<SumOrder::ordered>) << '\n';   // 218
+    
+    // pence in uk coins
+    std::vector<int> coins = { 1, 2, 5, 10, 20, 50, 100, 200 };
+    std::cout << count_sum(200, coins, count_sum_checked<>) << '\n';    // 73'682
+    std::cout << count_sum(100'000, coins, count_sum_mod<>) << '\n';    // 836'633'026
+    std::cout << count_sum(100'000'000, coins, count_sum_mod<>) << '\n';    // 460'217'604, cache sized blocks
+    std::cout << count_sum(100'000, coins, count_sum_big<>) << '\n';    // 10'056'050'940'818'192'726'001
+    
+    // fib(101) ways with ones and twos, past 64 bits
+    std::vector<int> numbers2 = { 1, 2 };
+    std::cout << count_sum(100, numbers2, count_sum_checked<SumOrder::ordered>) << '\n';    // overflow
+    std::cout << count_sum(100, numbers2, count_sum_big<SumOrder::ordered>) << '\n';    // 573'147'844'013'817'084'101
+    std::cout << count_sum(100, numbers2, count_sum_mod<SumOrder::ordered>) << '\n';    // 782'204'094
+}
+//
+// CAN SUN CALLER
+//
+using CanSumFunc = bool(*)(const int&, const std::vector<int>&);
+
+template<SolverFor<bool, const int&, const std::vector<int>&> F>
+bool can_sum(const int &target, const std::vector<int> &numbers, F can_sum_func)
+{
+    if(target < 0){
+        std::clog << "Negative number! Invalid." << std::endl;
+        return false;
+    }
+    else if(target == 0) return true;
+    return can_sum_func(target, numbers);
+}
+
+bool can_sum(const int &target, const std::vector<int> &numbers, CanSumFunc can_sum_func = can_sum_tab)
+{
+    return can_sum<CanSumFunc>(target, numbers, can_sum_func);
+}
+
+void test_can_sum(bool(*can_sum_func)(const int&, const std::vector<int>&))
+{
+    std::cout << std::boolalpha;
+    std::vector<int> numbers1 = { 2, 3 };
+    std::cout << can_sum(7, numbers1, can_sum_func) << std::endl;     // true
+    std::vector<int> numbers2 = { 5, 3, 4, 7 };
+    std::cout << can_sum(7, numbers2, can_sum_func) << std::endl;     // true
+    std::vector<int> numbers3 = { 2, 4 };
+    std::cout << can_sum(7, numbers3, can_sum_func) << std::endl;     // false
+    std::vector<int> numbers4 = { 2, 3, 5 };
+    std::cout << can_sum(8, numbers4, can_sum_func) << std::endl;     // true
+    std::vector<int> numbers5 = { 7, 14 };
+    std::cout << can_sum(300, numbers5, can_sum_func) << std::endl;   // false
+}
+//
+// HOW SUM RECURSION
+//
+std::vector<int> how_sum_recu(const int &target, const std::vector<int> &numbers)
+{
+    // O(n ^ m * m) time
+    // O(m) space
+    DP_STATS_CALL();
+    if (target == 0) return {};
+    std::vector<int> null_vector = {0};
+    if (target < 0) return null_vector;
+    
+    for (int number : numbers){
+        const int remainder = target - number;
+        std::vector<int> remainder_result = how_sum_recu(remainder, numbers);
+        if (remainder_result != null_vector){
+            remainder_result.push_back(number);
+            return remainder_result;
+        }
+    }
+    return null_vector;
 }
 //
 // HOW SUM MEMOIZATION
 //
-std::vector<int> how_sum_memo(const int &target, const std::vector<int> &numbers, std::map<int, std::vector<int>>& memo){
-    if (memo.count(target)) return memo[target];
+template<typename Memo>
+std::vector<int> how_sum_memo(const int &target, const std::vector<int> &numbers, Memo &memo){
+    DP_STATS_CALL();
     if (target == 0) return {};
     const std::vector<int> null_vector = {0};
     if (target < 0) return null_vector;
+    if (const auto *hit = memo.find(target)) return *hit;
     
     for (int number : numbers){
         const int remainder = target - number;
         std::vector<int> remainder_result = how_sum_memo(remainder, numbers, memo);
         if (remainder_result != null_vector){
             remainder_result.push_back(number);
-            memo[target] = remainder_result;
-            return memo[target];
+            return memo.store(target, std::move(remainder_result));
         }
     }
-    memo[target] = null_vector;
+    memo.store(target, null_vector);
     return null_vector;
 }
 
 // how_sum overload
 std::vector<int> how_sum_memo(const int &target, const std::vector<int> &numbers)
 {
-    std::map<int, std::vector<int>> memo;
+    DenseMemo<std::vector<int>> memo(target + 1);
     return how_sum_memo(target, numbers, memo);
 }
 //
+// HOW SUM EXPLICIT STACK
+//
+// how_sum_memo on a heap stack, a frame's combination stays empty until a remainder
+// works out, the target itself is never 0 once it has a frame
+struct HowSumStack
+{
+    using key_type = int;
+    using value_type = std::vector<int>;
+    using state_type = std::vector<int>;
+
+    const std::vector<int> &numbers;
+    const std::vector<int> null_vector = { 0 };
+
+    bool base(const int target, std::vector<int> &out) const
+    {
+        out.clear();
+        return target == 0;
+    }
+    std::vector<int> start(int) const { return {}; }
+    std::size_t transitions(int) const { return numbers.size(); }
+    bool child(const int target, const std::size_t k, int &out) const
+    {
+        out = target - numbers[k];
+        return out >= 0;
+    }
+    bool fold(int, const std::size_t k, std::vector<int> &combination, const std::vector<int> &child) const
+    {
+        if(child == null_vector) return true;
+        combination = child;
+        combination.push_back(numbers[k]);
+        return false;
+    }
+    std::vector<int> finish(int, std::vector<int> &&combination) const
+    {
+        return combination.empty() ? null_vector : std::move(combination);
+    }
+};
+
+template<typename Memo>
+std::vector<int> how_sum_stack(const int &target, const std::vector<int> &numbers, Memo &memo)
+{
+    // time O(m^2 * n)
+    // space O(m^2), heap only
+    if(target < 0) return { 0 };
+    return memo_stack_solve(HowSumStack{numbers}, target, memo);
+}
+
+std::vector<int> how_sum_stack(const int &target, const std::vector<int> &numbers)
+{
+    DenseMemo<std::vector<int>> memo(target + 1);
+    return how_sum_stack(target, numbers, memo);
+}
+//
 // HOW SUM TABULATION
 //
 std::vector<int> how_sum_tab(const int &target, const std::vector<int> &numbers)
 {
     // O(m^2*n) time
     // O(m^2) space
+    DP_STATS_CALL();
     std::vector<int> null_vector(1, 0);
     std::vector<std::vector<int>> table(target+1, null_vector);
+    DP_STATS_BYTES(table.size() * (sizeof(std::vector<int>) + sizeof(int)));
     table[0] = {};
     
     for(int i = 0; i < table.size(); ++i){
@@ -334,6 +1244,8 @@ std::vector<int> how_sum_tab(const int &target, const std::vector<int> &numbers)
             for(int num : numbers){
                 if(i + num < table.size()){
                     // std::cout << i + num << '\n';
+                    DP_STATS_CELLS(1);
+                    DP_STATS_BYTES((table[i].size() + 1) * sizeof(int));
                     table[i + num] = table[i];
                     table[i + num].push_back(num);
                 }
@@ -343,9 +1255,90 @@ std::vector<int> how_sum_tab(const int &target, const std::vector<int> &numbers)
     return table[target];
 }
 //
+// HOW SUM PARENT POINTERS
+//
+// walks the predecessor chain back from target, terms come out in the order tabulation adds them
+std::vector<int> trace_parents(const std::vector<int> &parent, int target)
+{
+    std::vector<int> combination;
+    for(int i = target; i > 0; i = parent[i])
+        combination.push_back(i - parent[i]);
+    std::reverse(combination.begin(), combination.end());
+    return combination;
+}
+
+std::vector<int> how_sum_parent(const int &target, const std::vector<int> &numbers)
+{
+    // O(m*n) time
+    // O(m) space
+    std::vector<int> parent(target + 1, -1);    // sum the last term was added to, -1 unreachable
+    parent[0] = 0;
+    
+    for(int i = 0; i <= target; ++i){
+        if(parent[i] < 0) continue;
+        for(int num : numbers)
+            if(num > 0 && num <= target - i)
+                parent[i + num] = i;
+    }
+    if(parent[target] < 0) return {0};
+    return trace_parents(parent, target);
+}
+//
+// HOW SUM ARENA
+//
+// how_sum_memo with the memo and every combination in it carved out of an arena,
+// known[t] is 0 unknown, 1 no combination, 2 combination in memo[t]
+bool how_sum_arena(const int target, const std::vector<int> &numbers, std::pmr::vector<std::pmr::vector<int>> &memo, std::pmr::vector<char> &known)
+{
+    DP_STATS_CALL();
+    if(target == 0) return true;
+    if(target < 0) return false;
+    if(known[target]) return known[target] == 2;
+    
+    for(int number : numbers){
+        if(how_sum_arena(target - number, numbers, memo, known)){
+            const std::pmr::vector<int> &rest = memo[target - number];
+            memo[target].reserve(rest.size() + 1);  // nothing is freed, a regrowth would waste the first buffer
+            memo[target].assign(rest.begin(), rest.end());
+            memo[target].push_back(number);
+            known[target] = 2;
+            return true;
+        }
+    }
+    known[target] = 1;
+    return false;
+}
+
+// same combination as how_sum_memo, the arena is reset before and after the query
+std::vector<int> how_sum_arena(const int &target, const std::vector<int> &numbers, QueryArena &arena)
+{
+    // O(m^2 * n) time
+    // O(m^2) space, in the arena
+    if(target < 0) return {0};
+    arena.reset();
+    std::vector<int> result = { 0 };
+    {
+        std::pmr::vector<std::pmr::vector<int>> memo(target + 1, arena.resource());
+        std::pmr::vector<char> known(target + 1, 0, arena.resource());
+        if(how_sum_arena(target, numbers, memo, known)) result.assign(memo[target].begin(), memo[target].end());
+    }
+    arena.reset();
+    return result;
+}
+
+std::vector<int> how_sum_arena(const int &target, const std::vector<int> &numbers)
+{
+    static thread_local QueryArena arena;
+    return how_sum_arena(target, numbers, arena);
+}
+//
 // HOW SUM CALLER
 //
-std::vector<int> how_sum(const int &target, const std::vector<int> &numbers, std::vector<int>(*how_sum_func)(const int&, const std::vector<int>&))
+// how_sum and best_sum variants share a signature
+using SumFunc = std::vector<int>(*)(const int&, const std::vector<int>&);
+
+template<SolverFor<std::vector<int>, const int&, const std::vector<int>&> F>
+std::vector<int> how_sum(const int &target, const std::vector<int> &numbers, F how_sum_func)
 {
     if(target < 0){
         std::clog << "Negative number! Invalid." << std::endl;
@@ -354,6 +1347,11 @@ std::vector<int> how_sum(const int &target, const std::vector<int> &numbers, std
     return how_sum_func(target, numbers);
 }
 
+std::vector<int> how_sum(const int &target, const std::vector<int> &numbers, SumFunc how_sum_func)
+{
+    return how_sum<SumFunc>(target, numbers, how_sum_func);
+}
+
 void test_how_sum(std::vector<int>(*how_sum_func)(const int&, const std::vector<int>&))
 {
     std::vector<int> numbers1 = { 2, 3 };
@@ -374,8 +1372,9 @@ std::vector<int> best_sum_recu(const int &target, const std::vector<int> &number
 {
     // time O(n^m * m)
     // space O(m^2)
+    DP_STATS_CALL();
     if(target == 0) return {};
-    std::vector<int> null_vector = { '\0' };
+    std::vector<int> null_vector = { 0 };
     if(target < 0) return null_vector;
     
     std::vector<int> shortest_combination = null_vector;
@@ -384,11 +1383,11 @@ std::vector<int> best_sum_recu(const int &target, const std::vector<int> &number
         const int remainder = target - number;
         std::vector<int> remainder_combination = best_sum_recu(remainder, numbers);
         if(remainder_combination != null_vector){
-            std::vector<int> combination = remainder_combination;
+            std::vector<int> combination = std::move(remainder_combination);
             combination.push_back(number);
             // if the combination is shorter than the current "shortest", update it
             if(shortest_combination == null_vector || combination.size() < shortest_combination.size()){
-                shortest_combination = combination;
+                shortest_combination = std::move(combination);
             }
         }
     }
@@ -397,14 +1396,16 @@ std::vector<int> best_sum_recu(const int &target, const std::vector<int> &number
 //
 // BEST SUM MEMOIZATION
 //
-std::vector<int> best_sum_memo(const int &target, const std::vector<int> &numbers, std::map<int, std::vector<int>>& memo)
+template<typename Memo>
+std::vector<int> best_sum_memo(const int &target, const std::vector<int> &numbers, Memo &memo)
 {
     // time O(m^2 * n)
     // space O(m^2)
-    if(memo.count(target)) return memo[target];
+    DP_STATS_CALL();
     if(target == 0) return {};
-    std::vector<int> null_vector = { '\0' };
+    std::vector<int> null_vector = { 0 };
     if(target < 0) return null_vector;
+    if(const auto *hit = memo.find(target)) return *hit;
     
     std::vector<int> shortest_combination = null_vector;
     
@@ -412,43 +1413,100 @@ std::vector<int> best_sum_memo(const int &target, const std::vector<int> &number
         const int remainder = target - number;
         std::vector<int> remainder_combination = best_sum_memo(remainder, numbers, memo);
         if(remainder_combination != null_vector){
-            std::vector<int> combination = remainder_combination;
+            std::vector<int> combination = std::move(remainder_combination);
             combination.push_back(number);
             // if the combination is shorter than the current "shortest", update it
             if(shortest_combination == null_vector || combination.size() < shortest_combination.size()){
-                shortest_combination = combination;
+                shortest_combination = std::move(combination);
             }
         }
     }
-    memo[target] = shortest_combination;
-    return shortest_combination;
+    return memo.store(target, std::move(shortest_combination));
 }
 
 std::vector<int> best_sum_memo(const int &target, const std::vector<int> &numbers)
 {
-    std::map<int, std::vector<int>> memo;
+    DenseMemo<std::vector<int>> memo(target + 1);
     return best_sum_memo(target, numbers, memo);
 }
 //
+// BEST SUM EXPLICIT STACK
+//
+// best_sum_memo on a heap stack, the same empty until found combination as HowSumStack
+struct BestSumStack
+{
+    using key_type = int;
+    using value_type = std::vector<int>;
+    using state_type = std::vector<int>;
+
+    const std::vector<int> &numbers;
+    const std::vector<int> null_vector = { 0 };
+
+    bool base(const int target, std::vector<int> &out) const
+    {
+        out.clear();
+        return target == 0;
+    }
+    std::vector<int> start(int) const { return {}; }
+    std::size_t transitions(int) const { return numbers.size(); }
+    bool child(const int target, const std::size_t k, int &out) const
+    {
+        out = target - numbers[k];
+        return out >= 0;
+    }
+    bool fold(int, const std::size_t k, std::vector<int> &shortest, const std::vector<int> &child) const
+    {
+        // only copied when it wins
+        if(child != null_vector && (shortest.empty() || child.size() + 1 < shortest.size())){
+            shortest.assign(child.begin(), child.end());
+            shortest.push_back(numbers[k]);
+        }
+        return true;
+    }
+    std::vector<int> finish(int, std::vector<int> &&shortest) const
+    {
+        return shortest.empty() ? null_vector : std::move(shortest);
+    }
+};
+
+template<typename Memo>
+std::vector<int> best_sum_stack(const int &target, const std::vector<int> &numbers, Memo &memo)
+{
+    // time O(m^2 * n)
+    // space O(m^2), heap only
+    if(target < 0) return { 0 };
+    return memo_stack_solve(BestSumStack{numbers}, target, memo);
+}
+
+std::vector<int> best_sum_stack(const int &target, const std::vector<int> &numbers)
+{
+    DenseMemo<std::vector<int>> memo(target + 1);
+    return best_sum_stack(target, numbers, memo);
+}
+//
 // BEST SUM TABULATION
 //
 std::vector<int> best_sum_tab(const int &target, const std::vector<int> &numbers)
 {
     // time O(m^2 * n)
     // space O(m^2)
+    DP_STATS_CALL();
     const std::vector<int> null_vector(1, 0);
     std::vector<std::vector<int>> table(target + 1, null_vector);
+    DP_STATS_BYTES(table.size() * (sizeof(std::vector<int>) + sizeof(int)));
     table[0] = {};
     
     for(int i = 0; i < table.size(); ++i){
         if(table[i] != null_vector){
             for(int num : numbers){
                 if(i + num < table.size()){
+                    DP_STATS_CELLS(1);
+                    DP_STATS_BYTES((table[i].size() + 1) * sizeof(int));
                     std::vector<int> combination = table[i];
                     combination.push_back(num);
                     // printv(combination);
                     if(table[i + num] == null_vector || combination.size() < table[i + num].size())
-                        table[i + num] = combination;
+                        table[i + num] = std::move(combination);
                 }
             }
         }
@@ -456,9 +1514,122 @@ std::vector<int> best_sum_tab(const int &target, const std::vector<int> &numbers
     return table[target];
 }
 //
+// BEST SUM PARENT POINTERS
+//
+std::vector<int> best_sum_parent(const int &target, const std::vector<int> &numbers)
+{
+    // O(m*n) time
+    // O(m) space
+    std::vector<int> count(target + 1, -1);     // terms in the best combination, -1 unreachable
+    std::vector<int> parent(target + 1, -1);
+    count[0] = 0;
+    parent[0] = 0;
+    
+    for(int i = 0; i <= target; ++i){
+        if(count[i] < 0) continue;
+        for(int num : numbers){
+            if(num <= 0 || num > target - i) continue;
+            if(count[i + num] < 0 || count[i] + 1 < count[i + num]){
+                count[i + num] = count[i] + 1;
+                parent[i + num] = i;
+            }
+        }
+    }
+    if(count[target] < 0) return {0};
+    return trace_parents(parent, target);
+}
+//
+// BEST SUM BLOCKED
+//
+// rebuilds the combination best_sum_tab finds from a table of minimum term counts,
+// unreachable cells can hold any value that is never one less than a reachable count
+std::vector<int> trace_min_counts(const std::vector<int> &count, const std::vector<int> &numbers, const int target)
+{
+    // O(m * n) time for the combination of m terms
+    std::vector<int> combination;
+    for(int i = target; i > 0;){
+        // best_sum_tab keeps the first, so the lowest, predecessor reaching the minimum
+        int from = i;
+        for(int num : numbers)
+            if(num > 0 && num <= i && i - num < from && count[i - num] == count[i] - 1) from = i - num;
+        combination.push_back(i - from);
+        i = from;
+    }
+    std::reverse(combination.begin(), combination.end());
+    return combination;
+}
+
+std::vector<int> best_sum_blocked(const int &target, const std::vector<int> &numbers)
+{
+    // O(m*n / lanes / threads) time, blocks of min(numbers) cells are independent
+    // O(m) space
+    const std::vector<int> count = min_count_table(target, numbers);
+    if(count[target] == min_count_unreachable) return {0};
+    return trace_min_counts(count, numbers, target);
+}
+//
+// BEST SUM ARENA
+//
+// best_sum_memo with the memo in an arena, only the winning combination of each target
+// is copied instead of every candidate
+bool best_sum_arena(const int target, const std::vector<int> &numbers, std::pmr::vector<std::pmr::vector<int>> &memo, std::pmr::vector<char> &known)
+{
+    DP_STATS_CALL();
+    if(target == 0) return true;
+    if(target < 0) return false;
+    if(known[target]) return known[target] == 2;
+    
+    int best = -1;
+    std::size_t best_size = 0;
+    for(std::size_t i = 0; i < numbers.size(); ++i){
+        const int remainder = target - numbers[i];
+        if(!best_sum_arena(remainder, numbers, memo, known)) continue;
+        // strictly shorter, the first of equal length wins like in best_sum_memo
+        const std::size_t size = memo[remainder].size() + 1;
+        if(best < 0 || size < best_size){
+            best = static_cast<int>(i);
+            best_size = size;
+        }
+    }
+    if(best < 0){
+        known[target] = 1;
+        return false;
+    }
+    const int remainder = target - numbers[best];
+    memo[target].reserve(best_size);
+    memo[target].assign(memo[remainder].begin(), memo[remainder].end());
+    memo[target].push_back(numbers[best]);
+    known[target] = 2;
+    return true;
+}
+
+// same combination as best_sum_memo, the arena is reset before and after the query
+std::vector<int> best_sum_arena(const int &target, const std::vector<int> &numbers, QueryArena &arena)
+{
+    // time O(m^2 * n)
+    // space O(m^2), in the arena
+    if(target < 0) return {0};
+    arena.reset();
+    std::vector<int> result = { 0 };
+    {
+        std::pmr::vector<std::pmr::vector<int>> memo(target + 1, arena.resource());
+        std::pmr::vector<char> known(target + 1, 0, arena.resource());
+        if(best_sum_arena(target, numbers, memo, known)) result.assign(memo[target].begin(), memo[target].end());
+    }
+    arena.reset();
+    return result;
+}
+
+std::vector<int> best_sum_arena(const int &target, const std::vector<int> &numbers)
+{
+    static thread_local QueryArena arena;
+    return best_sum_arena(target, numbers, arena);
+}
+//
 // BEST SUM CALLER
 //
-std::vector<int> best_sum(const int &target, const std::vector<int> &numbers, std::vector<int>(*best_sum_func)(const int&, const std::vector<int>&))
+template<SolverFor<std::vector<int>, const int&, const std::vector<int>&> F>
+std::vector<int> best_sum(const int &target, const std::vector<int> &numbers, F best_sum_func)
 {
     if(target < 0){
         std::clog << "Negative number! Invalid." << std::endl;
@@ -467,6 +1638,11 @@ std::vector<int> best_sum(const int &target, const std::vector<int> &numbers, st
     return best_sum_func(target, numbers);
 }
 
+std::vector<int> best_sum(const int &target, const std::vector<int> &numbers, SumFunc best_sum_func)
+{
+    return best_sum<SumFunc>(target, numbers, best_sum_func);
+}
+
 void test_best_sum(std::vector<int>(*best_sum_func)(const int&, const std::vector<int>&))
 {
     std::vector<int> numbers1 = { 5, 3, 4, 7 };
@@ -479,18 +1655,104 @@ void test_best_sum(std::vector<int>(*best_sum_func)(const int&, const std::vecto
     printv(best_sum(100, numbers4, best_sum_func)); // {25, 25, 25, 25}
 }
 //
+// SUM BATCH
+//
+// a prepared number set answering many targets, the table of minimum term counts
+// is swept once and only extended when a target larger than any before comes in
+class SumTable
+{
+public:
+    explicit SumTable(std::vector<int> numbers) : numbers_(std::move(numbers)), count_{0} {}
+
+    int size() const { return static_cast<int>(count_.size()) - 1; }
+
+    void extend(const int target)
+    {
+        // O((target - size) * n) time
+        // O(target) space
+        const int first = static_cast<int>(count_.size());
+        if(target < first) return;
+        count_.resize(target + 1);
+        for(int i = first; i <= target; ++i){
+            int best = -1;
+            for(int num : numbers_){
+                if(num <= 0 || num > i || count_[i - num] < 0) continue;
+                if(best < 0 || count_[i - num] + 1 < best) best = count_[i - num] + 1;
+            }
+            count_[i] = best;
+        }
+    }
+
+    bool can_sum(const int target)
+    {
+        if(target < 0) return false;
+        extend(target);
+        return count_[target] >= 0;
+    }
+
+    // same combination as best_sum_tab, {0} when there is none
+    std::vector<int> best_sum(const int target)
+    {
+        // O(m * n) time for the combination of m terms
+        if(target < 0) return {};
+        extend(target);
+        if(count_[target] < 0) return {0};
+        return trace_min_counts(count_, numbers_, target);
+    }
+
+private:
+    std::vector<int> numbers_;
+    std::vector<int> count_;    // minimum number of terms, -1 when unreachable
+};
+
+std::vector<bool> can_sum_batch(const std::vector<int> &targets, const std::vector<int> &numbers)
+{
+    // O(max(targets) * n) time
+    // O(max(targets)) space
+    SumTable table(numbers);
+    if(!targets.empty()) table.extend(*std::max_element(targets.begin(), targets.end()));
+    std::vector<bool> result;
+    result.reserve(targets.size());
+    for(int target : targets) result.push_back(table.can_sum(target));
+    return result;
+}
+
+std::vector<std::vector<int>> best_sum_batch(const std::vector<int> &targets, const std::vector<int> &numbers)
+{
+    // O(max(targets) * n) time
+    // O(max(targets)) space
+    SumTable table(numbers);
+    if(!targets.empty()) table.extend(*std::max_element(targets.begin(), targets.end()));
+    std::vector<std::vector<int>> result;
+    result.reserve(targets.size());
+    for(int target : targets) result.push_back(table.best_sum(target));
+    return result;
+}
+
+void test_sum_batch()
+{
+    std::cout << std::boolalpha;
+    std::vector<int> numbers1 = { 2, 3, 5 };
+    printv(can_sum_batch({ 1, 7, 8, 300 }, numbers1));     // {false, true, true, true}
+    printv(best_sum_batch({ 8, 1, 10 }, numbers1));         // {{3, 5}, {0}, {5, 5}}
+    
+    SumTable table({ 1, 2, 5, 25 });
+    printv(table.best_sum(8));      // {1, 2, 5}
+    printv(table.best_sum(100));    // {25, 25, 25, 25}, extends the table from 8 to 100
+}
+//
 // CAN CONSTRUCT RECURSION
 //
 bool can_construct_recu(const std::string &target, const std::vector<std::string> &word_bank)
 {
     // time O(n^m*m)
     // space O(m^2)
+    DP_STATS_CALL();
     if(target == "") return true;
     
-    for(std::string word : word_bank){
+    for(const std::string &word : word_bank){
         if(target.find(word) == 0){
-            std::string suffix = target;
-            suffix.erase(0, word.size());
+            const std::string suffix = target.substr(word.size());
             if(can_construct_recu(suffix, word_bank))
                 return true;
         }
@@ -500,62 +1762,164 @@ bool can_construct_recu(const std::string &target, const std::vector<std::string
 //
 // CAN CONSTRUCT MEMOIZATION
 //
-bool can_construct_memo(const std::string &target, const std::vector<std::string> &word_bank, std::map<std::string, bool> &memo)
+template<typename Memo>
+bool can_construct_memo(const std::string &target, const std::vector<std::string> &word_bank, Memo &memo)
 {
     // time O(n*m^2)
     // space O(m^2)
-    if(memo.count(target)) return memo[target];
+    DP_STATS_CALL();
     if(target == "") return true;
+    if(const auto *hit = memo.find(target)) return *hit;
     
-    for(std::string word : word_bank){
+    for(const std::string &word : word_bank){
         if(target.find(word) == 0){
-            std::string suffix = target;
-            suffix.erase(0, word.size());
+            const std::string suffix = target.substr(word.size());
             if(can_construct_memo(suffix, word_bank, memo)){
-                memo[target] = true;
+                memo.store(target, true);
                 return true;
             } 
         }
     }
-    memo[target] = false;
+    memo.store(target, false);
     return false;
 }
 
 bool can_construct_memo(const std::string &target, const std::vector<std::string> &word_bank)
 {
-    std::map<std::string, bool> memo;
+    FlatHashMemo<std::string, bool> memo(target.size() + 1);
     return can_construct_memo(target, word_bank, memo);
 }
 //
-// CAN CONSTRUCT TABULATION
+// CAN CONSTRUCT OFFSET MEMOIZATION
 //
-bool can_construct_tab(const std::string &target, const std::vector<std::string> &word_bank)
+// recurses on an offset into one shared view, the memo is indexed by offset
+template<typename Memo>
+bool can_construct_offset(const std::string_view target, const std::size_t offset, const std::vector<std::string> &word_bank, Memo &memo)
 {
-    // time O(m*n*m)
+    // time O(n*m*w), w the longest word
     // space O(m)
-    std::vector<bool> table(target.size()+1, false);
-    table[0] = true;
+    DP_STATS_CALL();
+    if(offset == target.size()) return true;
+    if(const auto *hit = memo.find(offset)) return *hit;
     
-    for(int i = 0; i < table.size(); ++i){
-        if(table[i]){
-            for(std::string word : word_bank){
-                if(target.substr(i, word.size()) == word){
-                    table[i + word.size()] = true;
-                }
-            }
+    const std::string_view rest = target.substr(offset);
+    for(const std::string &word : word_bank){
+        if(!word.empty() && rest.starts_with(word) && can_construct_offset(target, offset + word.size(), word_bank, memo)){
+            memo.store(offset, true);
+            return true;
         }
     }
+    memo.store(offset, false);
+    return false;
+}
+
+bool can_construct_offset(const std::string &target, const std::vector<std::string> &word_bank)
+{
+    DenseMemo<bool> memo(target.size() + 1);
+    return can_construct_offset(target, 0, word_bank, memo);
+}
+//
+// CAN CONSTRUCT EXPLICIT STACK
+//
+// the *_offset memos on a heap stack, a key is an offset into target and transition k
+// takes word k if the rest starts with it, the count and all variants share this part
+struct ConstructStack
+{
+    using key_type = std::size_t;
+
+    std::string_view target;
+    const std::vector<std::string> &word_bank;
+
+    std::size_t transitions(std::size_t) const { return word_bank.size(); }
+    bool child(const std::size_t offset, const std::size_t k, std::size_t &out) const
+    {
+        const std::string &word = word_bank[k];
+        out = offset + word.size();
+        return !word.empty() && target.substr(offset).starts_with(word);
+    }
+};
+
+struct CanConstructStack : ConstructStack
+{
+    using value_type = bool;
+    using state_type = bool;
+
+    bool base(const std::size_t offset, bool &out) const
+    {
+        out = true;
+        return offset == target.size();
+    }
+    bool start(std::size_t) const { return false; }
+    bool fold(std::size_t, std::size_t, bool &found, const bool child) const
+    {
+        found = child;
+        return !found;
+    }
+    bool finish(std::size_t, bool &&found) const { return found; }
+};
+
+template<typename Memo>
+bool can_construct_stack(const std::string_view target, const std::vector<std::string> &word_bank, Memo &memo)
+{
+    // time O(n*m*w), w the longest word
+    // space O(m), heap only
+    return memo_stack_solve(CanConstructStack{{target, word_bank}}, 0, memo);
+}
+
+bool can_construct_stack(const std::string &target, const std::vector<std::string> &word_bank)
+{
+    DenseMemo<bool> memo(target.size() + 1);
+    return can_construct_stack(target, word_bank, memo);
+}
+//
+// CAN CONSTRUCT TABULATION
+//
+// table is scratch, reused between targets it saves the allocation
+bool can_construct_tab(const std::string_view target, const WordIndex &index, std::vector<char> &table)
+{
+    // time O(m + matches)
+    // space O(m)
+    DP_STATS_CALL();
+    DP_STATS_PHASE("fill");
+    DP_STATS_BYTES(target.size() + 1 > table.capacity() ? target.size() + 1 : 0);
+    table.assign(target.size() + 1, false);
+    table[0] = true;
+    
+    // matches come in increasing end, every cell before it is final
+    index.for_each_match(target, [&](const std::size_t end, const int word){
+        DP_STATS_CELLS(1);
+        if(table[end - index.word(word).size()]) table[end] = true;
+    });
     return table[target.size()];
 }
+
+bool can_construct_tab(const std::string &target, const WordIndex &index)
+{
+    std::vector<char> table;
+    return can_construct_tab(target, index, table);
+}
+
+bool can_construct_tab(const std::string &target, const std::vector<std::string> &word_bank)
+{
+    return can_construct_tab(target, WordIndex(word_bank));
+}
 //
 // CAN CONSTRUCT CALLER
 //
-bool can_construct(const std::string &target, const std::vector<std::string> &word_bank, bool(*can_construct_func)(const std::string&, const std::vector<std::string>&))
+using CanConstructFunc = bool(*)(const std::string&, const std::vector<std::string>&);
+
+template<SolverFor<bool, const std::string&, const std::vector<std::string>&> F>
+bool can_construct(const std::string &target, const std::vector<std::string> &word_bank, F can_construct_func)
 {
     if(!target.size()) return true;
     return can_construct_func(target, word_bank);
 }
 
+bool can_construct(const std::string &target, const std::vector<std::string> &word_bank, CanConstructFunc can_construct_func)
+{
+    return can_construct<CanConstructFunc>(target, word_bank, can_construct_func);
+}
+
 void test_can_construct(bool(*can_construct_func)(const std::string&, const std::vector<std::string>&))
 {
     std::cout << std::boolalpha;
@@ -576,13 +1940,13 @@ void test_can_construct(bool(*can_construct_func)(const std::string&, const std:
 //
 int count_construct_recu(const std::string &target, const std::vector<std::string> &word_bank)
 {
+    DP_STATS_CALL();
     if(target == "") return 1;
     int total_count = 0;
     
-    for(std::string word : word_bank){
+    for(const std::string &word : word_bank){
         if(target.find(word) == 0){
-            std::string suffix = target;
-            suffix.erase(0, word.size());
+            const std::string suffix = target.substr(word.size());
             int num_ways_for_rest = count_construct_recu(suffix, word_bank);
             total_count += num_ways_for_rest;
         }
@@ -592,60 +1956,178 @@ int count_construct_recu(const std::string &target, const std::vector<std::strin
 //
 // COUNT CONSTRUCT MEMOIZATION
 //
-int count_construct_memo(const std::string &target, const std::vector<std::string> &word_bank, std::map<std::string, int> &memo)
+template<typename Memo>
+int count_construct_memo(const std::string &target, const std::vector<std::string> &word_bank, Memo &memo)
 {
     // time(n*m^2)
     // space(m^2)
-    if(memo.count(target)) return memo[target];
+    DP_STATS_CALL();
     if(target == "") return 1;
+    if(const auto *hit = memo.find(target)) return *hit;
     int total_count = 0;
     
-    for(std::string word : word_bank){
+    for(const std::string &word : word_bank){
         if(target.find(word) == 0){
-            std::string suffix = target;
-            suffix.erase(0, word.size());
+            const std::string suffix = target.substr(word.size());
             int num_ways_for_rest = count_construct_memo(suffix, word_bank, memo);
             total_count += num_ways_for_rest;
         }
     }
-    memo[target] = total_count;
-    return total_count;
+    return memo.store(target, total_count);
 }
 
 int count_construct_memo(const std::string &target, const std::vector<std::string> &word_bank)
 {
-    std::map<std::string, int> memo;
+    FlatHashMemo<std::string, int> memo(target.size() + 1);
     return count_construct_memo(target, word_bank, memo);
 }
 //
-// COUNT CONSTRUCT TABULATION
+// COUNT CONSTRUCT OFFSET MEMOIZATION
 //
-int count_construct_tab(const std::string &target, const std::vector<std::string> &word_bank)
+template<typename Memo>
+int count_construct_offset(const std::string_view target, const std::size_t offset, const std::vector<std::string> &word_bank, Memo &memo)
+{
+    // time O(n*m*w)
+    // space O(m)
+    DP_STATS_CALL();
+    if(offset == target.size()) return 1;
+    if(const auto *hit = memo.find(offset)) return *hit;
+    
+    const std::string_view rest = target.substr(offset);
+    int total_count = 0;
+    for(const std::string &word : word_bank)
+        if(!word.empty() && rest.starts_with(word))
+            total_count += count_construct_offset(target, offset + word.size(), word_bank, memo);
+    return memo.store(offset, total_count);
+}
+
+int count_construct_offset(const std::string &target, const std::vector<std::string> &word_bank)
+{
+    DenseMemo<int> memo(target.size() + 1);
+    return count_construct_offset(target, 0, word_bank, memo);
+}
+//
+// COUNT CONSTRUCT EXPLICIT STACK
+//
+struct CountConstructStack : ConstructStack
+{
+    using value_type = int;
+    using state_type = int;
+
+    bool base(const std::size_t offset, int &out) const
+    {
+        out = 1;
+        return offset == target.size();
+    }
+    int start(std::size_t) const { return 0; }
+    bool fold(std::size_t, std::size_t, int &total_count, const int child) const
+    {
+        total_count += child;
+        return true;
+    }
+    int finish(std::size_t, int &&total_count) const { return total_count; }
+};
+
+template<typename Memo>
+int count_construct_stack(const std::string_view target, const std::vector<std::string> &word_bank, Memo &memo)
+{
+    // time O(n*m*w)
+    // space O(m), heap only
+    return memo_stack_solve(CountConstructStack{{target, word_bank}}, 0, memo);
+}
+
+int count_construct_stack(const std::string &target, const std::vector<std::string> &word_bank)
 {
-    // time O(m^2*n)
+    DenseMemo<int> memo(target.size() + 1);
+    return count_construct_stack(target, word_bank, memo);
+}
+//
+// COUNT CONSTRUCT TABULATION
+//
+int count_construct_tab(const std::string &target, const WordIndex &index)
+{
+    // time O(m + matches)
     // space O(m)
+    DP_STATS_CALL();
+    DP_STATS_PHASE("fill");
     std::vector<int> table(target.size() + 1, 0);
+    DP_STATS_BYTES(table.size() * sizeof(int));
     table[0] = 1;
     
-    for(int i = 0; i < table.size(); ++i){
-        for(std::string word : word_bank){
-            if(target.substr(i, word.size()) == word){
-                // std::cout << target.substr(i, i + word.size()) << " = " << word << '\n';
-                table[i + word.size()] += table[i];
-            }
-        }
-    }
+    index.for_each_match(target, [&](const std::size_t end, const int word){
+        DP_STATS_CELLS(1);
+        table[end] += table[end - index.word(word).size()];
+    });
+    return table[target.size()];
+}
+
+int count_construct_tab(const std::string &target, const std::vector<std::string> &word_bank)
+{
+    return count_construct_tab(target, WordIndex(word_bank));
+}
+//
+// COUNT CONSTRUCT COUNT MODES
+//
+// the same tabulation over BigUint, CheckedCount or ModCount instead of an overflowing int
+template<typename Count>
+Count count_construct_as(const std::string_view target, const WordIndex &index, std::vector<Count> &table)
+{
+    // time O(m + matches) additions of Count
+    // space O(m)
+    DP_STATS_CALL();
+    DP_STATS_PHASE("fill");
+    DP_STATS_BYTES(target.size() + 1 > table.capacity() ? (target.size() + 1) * sizeof(Count) : 0);
+    table.assign(target.size() + 1, Count(0));
+    table[0] = Count(1);
+    
+    index.for_each_match(target, [&](const std::size_t end, const int word){
+        DP_STATS_CELLS(1);
+        table[end] += table[end - index.word(word).size()];
+    });
     return table[target.size()];
 }
+
+template<typename Count>
+Count count_construct_as(const std::string &target, const WordIndex &index)
+{
+    std::vector<Count> table;
+    return count_construct_as<Count>(target, index, table);
+}
+
+BigUint count_construct_big(const std::string &target, const std::vector<std::string> &word_bank)
+{
+    return count_construct_as<BigUint>(target, WordIndex(word_bank));
+}
+
+CheckedCount count_construct_checked(const std::string &target, const std::vector<std::string> &word_bank)
+{
+    return count_construct_as<CheckedCount>(target, WordIndex(word_bank));
+}
+
+template<std::uint32_t P = 1'000'000'007>
+ModCount<P> count_construct_mod(const std::string &target, const std::vector<std::string> &word_bank)
+{
+    return count_construct_as<ModCount<P>>(target, WordIndex(word_bank));
+}
 //
 // COUNT CONSTRUCT CALLER
 //
-int count_construct(const std::string &target, const std::vector<std::string> &word_bank, int(*count_construct_func)(const std::string&, const std::vector<std::string>&))
+using CountConstructFunc = int(*)(const std::string&, const std::vector<std::string>&);
+
+// Count is whatever the variant returns, int, BigUint, CheckedCount or ModCount
+template<typename F, typename Count = std::invoke_result_t<const F&, const std::string&, const std::vector<std::string>&>>
+    requires SolverFor<F, Count, const std::string&, const std::vector<std::string>&>
+Count count_construct(const std::string &target, const std::vector<std::string> &word_bank, F count_construct_func)
 {
-    if(!target.size()) return 1;
+    if(!target.size()) return Count(1);
     return count_construct_func(target, word_bank);
 }
 
+int count_construct(const std::string &target, const std::vector<std::string> &word_bank, CountConstructFunc count_construct_func)
+{
+    return count_construct<CountConstructFunc>(target, word_bank, count_construct_func);
+}
+
 void test_count_construct(int(*count_construct_func)(const std::string&, const std::vector<std::string>&))
 {
     std::vector<std::string> strs1 = { "purp", "p", "ur", "le", "purpl" };
@@ -663,6 +2145,84 @@ void test_count_construct(int(*count_construct_func)(const std::string&, const s
     std::vector<std::string> strs5 = { "e", "ee", "eee", "eeee", "eeeee", "eeeeee" };
     std::cout << count_construct_func("eeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeef", strs5) << '\n';     // 0
 }
+
+void test_count_construct_modes()
+{
+    std::vector<std::string> strs1 = { "a", "aa", "aaa" };
+    const std::string target1(100, 'a');
+    std::cout << count_construct(target1, strs1, count_construct_big) << '\n';        // 180'396'380'815'100'901'214'157'639
+    std::cout << count_construct(target1, strs1, count_construct_checked) << '\n';    // overflow
+    std::cout << count_construct(target1, strs1, count_construct_mod<>) << '\n';      // 347'873'931
+    
+    const std::string target2(70, 'a');
+    std::cout << count_construct(target2, strs1, count_construct_checked) << '\n';    // 2'073'693'258'389'777'176
+}
+//
+// CONSTRUCT BATCH
+//
+// one word bank against many targets, the automaton is built once and the targets go
+// to a work stealing pool in chunks, each thread fills one table it reuses for every
+// target it runs, answers come back in input order
+// one batch call at a time per object, the pool's outside slot is the caller's
+class ConstructBatch
+{
+public:
+    explicit ConstructBatch(const std::vector<std::string> &word_bank, const unsigned threads = 0) : index_(word_bank), pool_(threads) {}
+
+    const WordIndex& index() const { return index_; }
+    unsigned threads() const { return pool_.size(); }
+
+    std::vector<bool> can_construct(const std::span<const std::string> targets)
+    {
+        // O(total length + matches) time over the threads
+        // O(longest target) space per thread
+        std::vector<char> reach(targets.size());
+        std::vector<std::vector<char>> scratch(pool_.size());
+        pool_.for_each_chunk(targets.size(), chunk_size(targets.size()), [&](const std::size_t begin, const std::size_t end){
+            std::vector<char> &table = scratch[pool_.worker()];
+            for(std::size_t i = begin; i < end; ++i)
+                reach[i] = can_construct_tab(targets[i], index_, table);
+        });
+        return std::vector<bool>(reach.begin(), reach.end());
+    }
+
+    // Count as in count_construct_as, int overflows like count_construct_tab
+    template<typename Count = int>
+    std::vector<Count> count_construct(const std::span<const std::string> targets)
+    {
+        // O(total length + matches) time over the threads
+        // O(longest target) space per thread
+        std::vector<Count> counts(targets.size(), Count(0));
+        std::vector<std::vector<Count>> scratch(pool_.size());
+        pool_.for_each_chunk(targets.size(), chunk_size(targets.size()), [&](const std::size_t begin, const std::size_t end){
+            std::vector<Count> &table = scratch[pool_.worker()];
+            for(std::size_t i = begin; i < end; ++i)
+                counts[i] = count_construct_as<Count>(targets[i], index_, table);
+        });
+        return counts;
+    }
+
+private:
+    WordIndex index_;
+    ThreadPool pool_;
+
+    // about eight chunks per thread leaves room to steal without making a task per target
+    std::size_t chunk_size(const std::size_t count) const
+    {
+        return std::clamp<std::size_t>(count / (8 * pool_.size()), 1, 1'024);
+    }
+};
+
+void test_construct_batch()
+{
+    std::vector<std::string> strs = { "a", "p", "ent", "enter", "ot", "o", "t" };
+    ConstructBatch batch(strs, 4);
+    std::vector<std::string> targets = { "enterapotentpot", "skateboard", "", "potato", "entertot" };
+    for(bool reach : batch.can_construct(targets)) std::cout << std::boolalpha << reach << ' ';
+    std::cout << '\n';     // true false true true true
+    for(int count : batch.count_construct(targets)) std::cout << count << ' ';
+    std::cout << '\n';     // 4 0 1 2 2
+}
 //
 // ALL CONSTRUCT RECURSION
 //
@@ -670,21 +2230,20 @@ std::vector<std::vector<std::string>> all_construct_recu(const std::string &targ
 {
     // time O(n^m)
     // space O(m)
+    DP_STATS_CALL();
     if(target == "") return {{}};
     std::vector<std::vector<std::string>> result;
     
-    for(std::string word : word_bank){
+    for(const std::string &word : word_bank){
         if(target.find(word) == 0){
-            std::string suffix = target;
-            suffix.erase(0, word.size());
+            const std::string suffix = target.substr(word.size());
             // std::cout << suffix << '\n';
             std::vector<std::vector<std::string>> suffix_ways = all_construct_recu(suffix, word_bank);
             // printv(suffix_ways);
-            std::vector<std::vector<std::string>> target_ways = suffix_ways;
-            for(int i = 0; i < target_ways.size(); ++i){
-                target_ways[i].insert(target_ways[i].begin(), word);
+            for(std::vector<std::string> &way : suffix_ways){
+                way.insert(way.begin(), word);
+                result.push_back(std::move(way));
             }
-            result.insert(std::end(result), std::begin(target_ways), std::end(target_ways));
         }
     }
     return result;
@@ -692,74 +2251,497 @@ std::vector<std::vector<std::string>> all_construct_recu(const std::string &targ
 //
 // ALL CONSTRUCT MEMOIZATION
 //
-std::vector<std::vector<std::string>> all_construct_memo(const std::string &target, const std::vector<std::string> &word_bank, std::map<std::string, std::vector<std::vector<std::string>>> &memo)
+template<typename Memo>
+std::vector<std::vector<std::string>> all_construct_memo(const std::string &target, const std::vector<std::string> &word_bank, Memo &memo)
 {
     // time O(n^m)
     // space O(m)
     // this memoization doesn't really help in the worst case scenario
     // but can optimize some results
-    if(memo.count(target)) return memo[target];
+    DP_STATS_CALL();
     if(target == "") return {{}};
+    if(const auto *hit = memo.find(target)) return *hit;
     
     std::vector<std::vector<std::string>> result;
     
-    for(std::string word : word_bank){
+    for(const std::string &word : word_bank){
         if(target.find(word) == 0){
-            std::string suffix = target;
-            suffix.erase(0, word.size());
+            const std::string suffix = target.substr(word.size());
             std::vector<std::vector<std::string>> suffix_ways = all_construct_memo(suffix, word_bank, memo);
-            std::vector<std::vector<std::string>> target_ways = suffix_ways;
-            for(int i = 0; i < target_ways.size(); ++i){
-                target_ways[i].insert(target_ways[i].begin(), word);
+            for(std::vector<std::string> &way : suffix_ways){
+                way.insert(way.begin(), word);
+                result.push_back(std::move(way));
             }
-            result.insert(std::end(result), std::begin(target_ways), std::end(target_ways));
         }
     }
-    memo[target] = result;
-    return result;
+    return memo.store(target, std::move(result));
 }
 
 // all construct overload
 std::vector<std::vector<std::string>> all_construct_memo(const std::string &target, const std::vector<std::string> &word_bank)
 {
-    std::map<std::string, std::vector<std::vector<std::string>>> memo;
+    FlatHashMemo<std::string, std::vector<std::vector<std::string>>> memo(target.size() + 1);
     return all_construct_memo(target, word_bank, memo);
 }
 //
+// ALL CONSTRUCT OFFSET MEMOIZATION
+//
+template<typename Memo>
+std::vector<std::vector<std::string>> all_construct_offset(const std::string_view target, const std::size_t offset, const std::vector<std::string> &word_bank, Memo &memo)
+{
+    // time O(n^m)
+    // space O(n^m), one result per offset instead of one per suffix string
+    DP_STATS_CALL();
+    if(offset == target.size()) return {{}};
+    if(const auto *hit = memo.find(offset)) return *hit;
+    
+    const std::string_view rest = target.substr(offset);
+    std::vector<std::vector<std::string>> result;
+    for(const std::string &word : word_bank){
+        if(word.empty() || !rest.starts_with(word)) continue;
+        std::vector<std::vector<std::string>> suffix_ways = all_construct_offset(target, offset + word.size(), word_bank, memo);
+        for(std::vector<std::string> &way : suffix_ways){
+            way.insert(way.begin(), word);
+            result.push_back(std::move(way));
+        }
+    }
+    return memo.store(offset, std::move(result));
+}
+
+std::vector<std::vector<std::string>> all_construct_offset(const std::string &target, const std::vector<std::string> &word_bank)
+{
+    DenseMemo<std::vector<std::vector<std::string>>> memo(target.size() + 1);
+    return all_construct_offset(target, 0, word_bank, memo);
+}
+//
+// ALL CONSTRUCT EXPLICIT STACK
+//
+struct AllConstructStack : ConstructStack
+{
+    using value_type = std::vector<std::vector<std::string>>;
+    using state_type = std::vector<std::vector<std::string>>;
+
+    bool base(const std::size_t offset, std::vector<std::vector<std::string>> &out) const
+    {
+        if(offset != target.size()) return false;
+        out = {{}};
+        return true;
+    }
+    std::vector<std::vector<std::string>> start(std::size_t) const { return {}; }
+    bool fold(std::size_t, const std::size_t k, std::vector<std::vector<std::string>> &result,
+              const std::vector<std::vector<std::string>> &suffix_ways) const
+    {
+        for(const std::vector<std::string> &suffix_way : suffix_ways){
+            std::vector<std::string> way;
+            way.reserve(suffix_way.size() + 1);
+            way.push_back(word_bank[k]);
+            way.insert(way.end(), suffix_way.begin(), suffix_way.end());
+            result.push_back(std::move(way));
+        }
+        return true;
+    }
+    std::vector<std::vector<std::string>> finish(std::size_t, std::vector<std::vector<std::string>> &&result) const
+    {
+        return std::move(result);
+    }
+};
+
+template<typename Memo>
+std::vector<std::vector<std::string>> all_construct_stack(const std::string_view target, const std::vector<std::string> &word_bank, Memo &memo)
+{
+    // time O(n^m)
+    // space O(n^m)
+    return memo_stack_solve(AllConstructStack{{target, word_bank}}, 0, memo);
+}
+
+std::vector<std::vector<std::string>> all_construct_stack(const std::string &target, const std::vector<std::string> &word_bank)
+{
+    DenseMemo<std::vector<std::vector<std::string>>> memo(target.size() + 1);
+    return all_construct_stack(target, word_bank, memo);
+}
+//
+// ALL CONSTRUCT ARENA
+//
+// all_construct_offset with the partial constructions held as word views in an arena,
+// strings are only built for the final result
+using ArenaWays = std::pmr::vector<std::pmr::vector<std::string_view>>;
+
+const ArenaWays& all_construct_arena(const std::string_view target, const std::size_t offset, const std::vector<std::string> &word_bank,
+                                     std::pmr::vector<ArenaWays> &memo, std::pmr::vector<char> &known)
+{
+    DP_STATS_CALL();
+    ArenaWays &result = memo[offset];
+    if(known[offset]) return result;
+    known[offset] = true;
+    if(offset == target.size()){
+        result.emplace_back();
+        return result;
+    }
+    
+    const std::string_view rest = target.substr(offset);
+    for(const std::string &word : word_bank){
+        if(word.empty() || !rest.starts_with(word)) continue;
+        const ArenaWays &suffix_ways = all_construct_arena(target, offset + word.size(), word_bank, memo, known);
+        for(const std::pmr::vector<std::string_view> &suffix_way : suffix_ways){
+            std::pmr::vector<std::string_view> &way = result.emplace_back();
+            way.reserve(suffix_way.size() + 1);
+            way.push_back(word);
+            way.insert(way.end(), suffix_way.begin(), suffix_way.end());
+        }
+    }
+    return result;
+}
+
+// same constructions and order as all_construct_recu, the arena is reset before and after the query
+std::vector<std::vector<std::string>> all_construct_arena(const std::string &target, const std::vector<std::string> &word_bank, QueryArena &arena)
+{
+    // time O(n^m)
+    // space O(n^m), in the arena
+    arena.reset();
+    std::vector<std::vector<std::string>> result;
+    {
+        std::pmr::vector<ArenaWays> memo(target.size() + 1, arena.resource());
+        std::pmr::vector<char> known(target.size() + 1, false, arena.resource());
+        const ArenaWays &ways = all_construct_arena(target, 0, word_bank, memo, known);
+        result.reserve(ways.size());
+        for(const std::pmr::vector<std::string_view> &way : ways)
+            result.emplace_back(way.begin(), way.end());
+    }
+    arena.reset();
+    return result;
+}
+
+std::vector<std::vector<std::string>> all_construct_arena(const std::string &target, const std::vector<std::string> &word_bank)
+{
+    static thread_local QueryArena arena;
+    return all_construct_arena(target, word_bank, arena);
+}
+//
 // ALL CONSTRUCT TABULATION
 //
-std::vector<std::vector<std::string>> all_construct_tab(const std::string &target, const std::vector<std::string> &word_bank)
+std::vector<std::vector<std::string>> all_construct_tab(const std::string &target, const WordIndex &index)
 {
     // time ~O(n^m)
     // space ~O(n^m)
+    DP_STATS_CALL();
+    DP_STATS_PHASE("fill");
     std::vector<std::vector<std::vector<std::string>>> table(target.size() + 1);
+    DP_STATS_BYTES(table.size() * sizeof(table[0]));
     table[0] = {{}};
-    std::cout << table.size();
     
-    for(int i = 0; i < table.size(); ++i){
-        for(std::string word : word_bank){
-            if(target.substr(i, word.size()) == word){
-                std::vector<std::vector<std::string>> new_combination = table[i];
-                for(int j = 0; j < new_combination.size(); ++j)
-                    new_combination[j].push_back(word);
-                table[i + word.size()].insert(table[i + word.size()].end(), new_combination.begin(), new_combination.end());
+    // matches at the same end come by increasing start, the order pushing from each start gives
+    index.for_each_match(target, [&](const std::size_t end, const int word){
+        const std::string &w = index.word(word);
+        const std::vector<std::vector<std::string>> &start_ways = table[end - w.size()];
+        std::vector<std::vector<std::string>> &end_ways = table[end];
+        DP_STATS_CELLS(1);
+        for(const std::vector<std::string> &way : start_ways){
+            DP_STATS_BYTES((way.size() + 1) * sizeof(std::string));
+            end_ways.push_back(way);
+            end_ways.back().push_back(w);
+        }
+    });
+    return table[target.size()];
+}
+
+std::vector<std::vector<std::string>> all_construct_tab(const std::string &target, const std::vector<std::string> &word_bank)
+{
+    return all_construct_tab(target, WordIndex(word_bank));
+}
+//
+// ALL CONSTRUCT GENERATOR
+//
+// yields the constructions one at a time in all_construct_recu order, the yielded
+// path is reused and only valid until the next one, branches whose suffix can't be
+// constructed are never entered
+struct ConstructFrame
+{
+    std::size_t pos;    // offset into target
+    int next;           // next entry of MatchStarts::ids to try
+};
+
+Generator<std::vector<std::string_view>> all_construct_gen(std::string target, std::vector<std::string> word_bank)
+{
+    // time O(m + matches) setup, O(m) per yielded construction
+    // space O(m + matches)
+    const WordIndex index(word_bank);
+    const MatchStarts starts = match_starts(target, index);
+    const std::vector<bool> reach = suffix_reach(target, index, starts);
+    if(!reach[0]) co_return;
+    
+    std::vector<ConstructFrame> stack = { { 0, starts.begin[0] } };
+    std::vector<std::string_view> path;
+    while(!stack.empty()){
+        ConstructFrame &top = stack.back();
+        if(top.pos == target.size()){
+            co_yield path;
+            stack.pop_back();
+            if(!path.empty()) path.pop_back();
+            continue;
+        }
+        bool descended = false;
+        while(top.next < starts.begin[top.pos + 1]){
+            const std::string &word = index.word(starts.ids[top.next++]);
+            const std::size_t next_pos = top.pos + word.size();
+            if(reach[next_pos]){
+                path.push_back(word);
+                stack.push_back({ next_pos, starts.begin[next_pos] });
+                descended = true;
+                break;
             }
         }
+        if(!descended){
+            stack.pop_back();
+            if(!path.empty()) path.pop_back();
+        }
     }
-    return table[target.size()];
+}
+//
+// ALL CONSTRUCT DAG
+//
+// every construction as a path through target offsets, edges are labeled by word bank
+// indices and only kept when the rest of the target can still be constructed
+// constructions are numbered in all_construct_recu order and counts saturate at 2^64 - 1,
+// a saturated dag has no numbering, at() and page() give nothing for it
+class ConstructDag
+{
+public:
+    ConstructDag(const std::string &target, const WordIndex &index) : words_(index.words())
+    {
+        // O(m + matches) time
+        // O(m + matches) space
+        DP_STATS_PHASE("dag");
+        const MatchStarts starts = match_starts(target, index);
+        const std::size_t m = target.size();
+        count_.assign(m + 1, 0);
+        count_[m] = 1;
+        for(std::size_t i = m; i-- > 0;){
+            for(int k = starts.begin[i]; k < starts.begin[i + 1]; ++k){
+                const std::uint64_t ways = count_[i + words_[starts.ids[k]].size()];
+                count_[i] = ways > max_count - count_[i] ? max_count : count_[i] + ways;
+            }
+        }
+        edge_begin_.assign(m + 2, 0);
+        for(std::size_t i = 0; i <= m; ++i){
+            edge_begin_[i] = static_cast<int>(edge_word_.size());
+            if(!count_[i]) continue;
+            for(int k = starts.begin[i]; k < starts.begin[i + 1]; ++k)
+                if(count_[i + words_[starts.ids[k]].size()])
+                    edge_word_.push_back(starts.ids[k]);
+        }
+        edge_begin_[m + 1] = static_cast<int>(edge_word_.size());
+    }
+
+    ConstructDag(const std::string &target, const std::vector<std::string> &word_bank)
+        : ConstructDag(target, WordIndex(word_bank)) {}
+
+    // O(1)
+    std::uint64_t size() const { return count_[0]; }
+    bool saturated() const { return count_[0] == max_count; }
+
+    // the graph itself, edges of offset pos are [edge_begin(pos), edge_end(pos))
+    std::size_t target_size() const { return count_.size() - 1; }
+    std::uint64_t count(const std::size_t pos) const { return count_[pos]; }
+    int edge_begin(const std::size_t pos) const { return edge_begin_[pos]; }
+    int edge_end(const std::size_t pos) const { return edge_begin_[pos + 1]; }
+    const std::string& edge_word(const int e) const { return words_[edge_word_[e]]; }
+
+    // the k-th construction, nullopt past the last one, O(m * words per offset)
+    std::optional<std::vector<std::string>> at(std::uint64_t k) const
+    {
+        if(k >= size() || saturated()) return std::nullopt;
+        std::vector<std::string> way;
+        for(std::size_t pos = 0; pos + 1 < count_.size();){
+            for(int e = edge_begin_[pos]; e < edge_begin_[pos + 1]; ++e){
+                const std::size_t next = pos + words_[edge_word_[e]].size();
+                if(k < count_[next]){
+                    way.push_back(words_[edge_word_[e]]);
+                    pos = next;
+                    break;
+                }
+                k -= count_[next];
+            }
+        }
+        return way;
+    }
+
+    // constructions [first, first + count), O(m) per construction after the first
+    std::vector<std::vector<std::string>> page(std::uint64_t first, const std::size_t count) const
+    {
+        std::vector<std::vector<std::string>> ways;
+        if(first >= size() || !count || saturated()) return ways;
+        const std::size_t m = count_.size() - 1;
+        
+        // descend to the first construction of the page
+        std::vector<int> stack;     // chosen edge at each level
+        std::vector<std::size_t> offsets = { 0 };
+        while(offsets.back() < m){
+            const std::size_t pos = offsets.back();
+            for(int e = edge_begin_[pos]; e < edge_begin_[pos + 1]; ++e){
+                const std::size_t next = pos + words_[edge_word_[e]].size();
+                if(first < count_[next]){
+                    stack.push_back(e);
+                    offsets.push_back(next);
+                    break;
+                }
+                first -= count_[next];
+            }
+        }
+        while(true){
+            std::vector<std::string> &way = ways.emplace_back();
+            for(int e : stack) way.push_back(words_[edge_word_[e]]);
+            if(ways.size() == count) break;
+            
+            // next construction: bump the deepest edge that has a sibling, then take first edges down
+            while(!stack.empty() && stack.back() + 1 == edge_begin_[offsets[offsets.size() - 2] + 1]){
+                stack.pop_back();
+                offsets.pop_back();
+            }
+            if(stack.empty()) break;
+            offsets.pop_back();
+            ++stack.back();
+            offsets.push_back(offsets.back() + words_[edge_word_[stack.back()]].size());
+            while(offsets.back() < m){
+                stack.push_back(edge_begin_[offsets.back()]);
+                offsets.push_back(offsets.back() + words_[edge_word_[stack.back()]].size());
+            }
+        }
+        return ways;
+    }
+
+private:
+    static constexpr std::uint64_t max_count = ~std::uint64_t(0);
+
+    std::vector<std::string> words_;
+    std::vector<std::uint64_t> count_;  // constructions of target[i ..]
+    std::vector<int> edge_begin_;       // offset -> range in edge_word_
+    std::vector<int> edge_word_;
+};
+
+std::vector<std::vector<std::string>> all_construct_dag(const std::string &target, const std::vector<std::string> &word_bank)
+{
+    // time O(m + matches + output)
+    // space O(m + matches + output)
+    const ConstructDag dag(target, word_bank);
+    return dag.page(0, dag.size());
+}
+//
+// ALL CONSTRUCT PARALLEL
+//
+// the constructions under each prefix are independent, a prefix whose suffix has more
+// than grain constructions is split into one task per next word and the pool balances
+// the tasks by stealing, smaller ones are walked depth first by a single thread
+// the dag counts give every prefix the rank of its first construction, so writing
+// each construction to its rank keeps all_construct_recu order with no merging
+// visit(worker, path, rank) with path a vector of word views reused by the walker
+template<typename Visit>
+void all_construct_walk(const ConstructDag &dag, ThreadPool &pool, const std::uint64_t grain,
+                        std::vector<std::string_view> path, const std::size_t pos, std::uint64_t rank, Visit &visit)
+{
+    constexpr std::uint64_t max_count = ~std::uint64_t(0);
+    const std::size_t m = dag.target_size();
+    if(pos < m && dag.count(pos) > grain){
+        ThreadPool::Group group;
+        for(int e = dag.edge_begin(pos); e < dag.edge_end(pos); ++e){
+            const std::size_t next = pos + dag.edge_word(e).size();
+            std::vector<std::string_view> branch = path;
+            branch.push_back(dag.edge_word(e));
+            pool.submit(group, [&dag, &pool, grain, &visit, branch = std::move(branch), next, rank]() mutable {
+                all_construct_walk(dag, pool, grain, std::move(branch), next, rank, visit);
+            });
+            rank = dag.count(next) > max_count - rank ? max_count : rank + dag.count(next);
+        }
+        pool.wait(group);
+        return;
+    }
+    
+    const unsigned worker = pool.worker();
+    const std::size_t depth = path.size();
+    std::vector<int> stack;     // chosen edge per level below depth
+    std::vector<std::size_t> offsets = { pos };
+    while(true){
+        if(offsets.back() == m){
+            visit(worker, path, rank++);
+        }
+        else{
+            // the dag only keeps edges that lead to m, so going down always ends there
+            stack.push_back(dag.edge_begin(offsets.back()));
+            path.push_back(dag.edge_word(stack.back()));
+            offsets.push_back(offsets.back() + path.back().size());
+            continue;
+        }
+        // next sibling of the deepest edge that has one
+        while(!stack.empty() && stack.back() + 1 == dag.edge_end(offsets[offsets.size() - 2])){
+            stack.pop_back();
+            offsets.pop_back();
+            path.pop_back();
+        }
+        if(stack.empty()) break;
+        offsets.pop_back();
+        path.pop_back();
+        ++stack.back();
+        path.push_back(dag.edge_word(stack.back()));
+        offsets.push_back(offsets.back() + path.back().size());
+    }
+    path.resize(depth);
+}
+
+// grain that leaves about 32 tasks per thread
+inline std::uint64_t all_construct_grain(const ConstructDag &dag, const ThreadPool &pool)
+{
+    return std::max<std::uint64_t>(64, dag.size() / (32 * pool.size()));
+}
+
+// streaming form, sink(worker, path) runs on the pool's threads in no particular order
+// between tasks, worker in [0, pool.size()) is for per thread buffers
+template<typename Sink>
+void all_construct_parallel(const ConstructDag &dag, ThreadPool &pool, Sink sink)
+{
+    // O(m + matches) setup, O(m) per construction over the threads
+    auto visit = [&sink](const unsigned worker, const std::vector<std::string_view> &path, std::uint64_t){ sink(worker, path); };
+    if(dag.size()) all_construct_walk(dag, pool, all_construct_grain(dag, pool), {}, 0, 0, visit);
+}
+
+// every construction in all_construct_recu order
+std::vector<std::vector<std::string>> all_construct_parallel(const std::string &target, const std::vector<std::string> &word_bank, ThreadPool &pool)
+{
+    // O(m + matches + output) work over the threads
+    // O(m + matches + output) space
+    const ConstructDag dag(target, word_bank);
+    if(dag.saturated()){
+        std::clog << "More than 2^64 - 1 constructions, use the streaming form." << std::endl;
+        return {};
+    }
+    std::vector<std::vector<std::string>> ways(dag.size());
+    auto visit = [&ways](unsigned, const std::vector<std::string_view> &path, const std::uint64_t rank){
+        ways[rank].assign(path.begin(), path.end());
+    };
+    if(dag.size()) all_construct_walk(dag, pool, all_construct_grain(dag, pool), {}, 0, 0, visit);
+    return ways;
+}
+
+std::vector<std::vector<std::string>> all_construct_parallel(const std::string &target, const std::vector<std::string> &word_bank)
+{
+    ThreadPool pool;
+    return all_construct_parallel(target, word_bank, pool);
 }
 //
 // ALL CONSTRUCT CALLER
 //
-std::vector<std::vector<std::string>> all_construct(
-    const std::string &target,
-    const std::vector<std::string> &word_bank,
-    std::vector<std::vector<std::string>>(*all_construct_func)(const std::string&, const std::vector<std::string>&))
+using AllConstructFunc = std::vector<std::vector<std::string>>(*)(const std::string&, const std::vector<std::string>&);
+
+template<SolverFor<std::vector<std::vector<std::string>>, const std::string&, const std::vector<std::string>&> F>
+std::vector<std::vector<std::string>> all_construct(const std::string &target, const std::vector<std::string> &word_bank, F all_construct_func)
 {
     if(!target.size()) return {{}};
     return all_construct_func(target, word_bank);
 }
 
+std::vector<std::vector<std::string>> all_construct(const std::string &target, const std::vector<std::string> &word_bank, AllConstructFunc all_construct_func)
+{
+    return all_construct<AllConstructFunc>(target, word_bank, all_construct_func);
+}
+
 void test_all_construct(std::vector<std::vector<std::string>>(*all_construct_func)(const std::string&, const std::vector<std::string>&))
 {
     std::vector<std::string> strs1 = { "purp", "p", "ur", "le", "purpl" };
@@ -787,7 +2769,346 @@ void test_all_construct(std::vector<std::vector<std::string>>(*all_construct_fun
     // { }
 }
 
+void test_all_construct_dag()
+{
+    std::vector<std::string> strs1 = { "ab", "abc", "cd", "def", "abcd" , "ef", "c"};
+    const ConstructDag dag1("abcdef", strs1);
+    std::cout << dag1.size() << '\n';     // 4
+    printv(*dag1.at(2));                    // {abc, def}
+    std::cout << std::boolalpha << dag1.at(4).has_value() << '\n';     // false
+    printv(dag1.page(1, 2));
+    // {
+    //     {ab, c, def},
+    //     {abc, def}
+    // }
+    
+    std::vector<std::string> strs2 = { "a", "aa", "aaa" };
+    const ConstructDag dag2(std::string(60, 'a'), strs2);
+    std::cout << dag2.size() << '\n';                 // 4'680'045'560'037'375
+    std::cout << dag2.at(dag2.size() - 1)->size() << '\n';  // 20, the last one is aaa twenty times
+    
+    const ConstructDag dag3(std::string(200, 'a'), strs2);
+    std::cout << dag3.saturated() << ' ' << dag3.at(0).has_value() << '\n';   // true false
+    
+    // no construction at all
+    const ConstructDag dag4("abcdefz", strs1);
+    std::cout << dag4.size() << ' ' << dag4.at(0).has_value() << ' ' << dag4.page(0, 1).size() << '\n';    // 0 false 0
+}
+
+void test_all_construct_gen()
+{
+    std::vector<std::string> strs1 = { "ab", "abc", "cd", "def", "abcd" , "ef", "c"};
+    for(const std::vector<std::string_view> &way : all_construct_gen("abcdef", strs1))
+        printv(way);
+    // {ab, cd, ef}
+    // {ab, c, def}
+    // {abc, def}
+    // {abcd, ef}
+    
+    std::vector<std::string> strs2 = { "a", "aa", "aaa", "aaaa", "aaaaa" };
+    // about 10^58 constructions, only the first three are ever built
+    Generator<std::vector<std::string_view>> ways = all_construct_gen(std::string(200, 'a'), strs2);
+    for(const std::vector<std::string_view> &way : take(ways, 3))
+        std::cout << way.size() << '\n';      // 200, 199, 199
+    
+    // nothing is enumerated, the 'z' makes every branch unreachable
+    Generator<std::vector<std::string_view>> none = all_construct_gen("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaz", strs2);
+    std::cout << std::boolalpha << none.next() << '\n';     // false
+}
+
+void test_solver_tags()
+{
+    // same answers as the pointer callers, through the inlined template callers
+    std::cout << fib(50, solver<fib_doubling>) << '\n';     // 12'586'269'025
+    std::cout << fib(50, solver<static_cast<FibFunc>(fib_memo)>) << '\n';     // 12'586'269'025
+    std::cout << grid_traveler(18, 18, solver<grid_traveler_roll<>>) << '\n';    // 2'333'606'220
+    std::vector<int> numbers = { 2, 3, 5 };
+    std::cout << std::boolalpha << can_sum(8, numbers, solver<can_sum_bits>) << '\n';   // true
+    printv(best_sum(8, numbers, solver<best_sum_parent>));     // {3, 5}
+    std::vector<std::string> strs = { "a", "aa", "aaa" };
+    std::cout << count_construct(std::string(100, 'a'), strs, solver<count_construct_mod<>>) << '\n';    // 347'873'931
+    // any callable works too
+    std::cout << count_construct("aaaa", strs, [](const std::string &target, const std::vector<std::string> &word_bank){
+        return count_construct_tab(target, word_bank);
+    }) << '\n';     // 7
+}
+
+void test_all_construct_parallel()
+{
+    ThreadPool pool(4);
+    std::vector<std::string> strs1 = { "ab", "abc", "cd", "def", "abcd" , "ef", "c"};
+    printv(all_construct_parallel("abcdef", strs1, pool));
+    // {
+    //     {ab, cd, ef},
+    //     {ab, c, def},
+    //     {abc, def},
+    //     {abcd, ef}
+    // }
+    
+    // per thread counters instead of materializing 53'798'080 constructions
+    std::vector<std::string> strs2 = { "a", "aa", "aaa" };
+    const ConstructDag dag(std::string(30, 'a'), strs2);
+    std::vector<std::uint64_t> ways(pool.size()), words(pool.size());
+    all_construct_parallel(dag, pool, [&](const unsigned worker, const std::vector<std::string_view> &path){
+        ++ways[worker];
+        words[worker] += path.size();
+    });
+    std::uint64_t total = 0;
+    for(std::uint64_t w : ways) total += w;
+    std::cout << total << '\n';   // 53'798'080
+}
+
+void test_solver_stats()
+{
+    // only counted when built with -DDP_STATS, all zero otherwise
+    std::vector<std::string> strs1 = { "e", "ee", "eee", "eeee", "eeeee", "eeeeee" };
+    const std::string target1 = "eeeeeeeeeeeeeeeeeeef";
+    std::cout << collect_stats([&]{ can_construct_recu(target1, strs1); }).calls << '\n';   // 471'712
+    const SolverStats memo1 = collect_stats([&]{ can_construct_memo(target1, strs1); });
+    std::cout << memo1.calls << ' ' << memo1.memo_hits << ' ' << memo1.memo_entries << '\n';    // 100 80 20
+    
+    // no suffix comes up twice, the memo only costs here
+    std::vector<std::string> strs2 = { "ab", "cd", "ef", "abc", "def" };
+    const SolverStats memo2 = collect_stats([&]{ all_construct_memo("abcdef", strs2); });
+    std::cout << memo2.memo_hits << ' ' << memo2.memo_misses << ' ' << memo2.max_depth << '\n';   // 0 4 4
+    
+    const SolverStats tab = collect_stats([&]{ count_construct_tab(target1, strs1); });
+    std::cout << tab.cells << ' ' << tab.phases.size() << '\n';     // 99 2, index and fill
+}
+
+void test_arena()
+{
+    // the arena variants against the *_memo ones on generated inputs, mismatches counted
+    std::uint32_t seed = 1;
+    const auto next = [&](const std::uint32_t bound){
+        seed = seed * 1'664'525 + 1'013'904'223;    // lcg
+        return (seed >> 16) % bound;
+    };
+    int mismatches = 0;
+    for(int i = 0; i < 2'000; ++i){
+        std::vector<int> numbers(1 + next(4));
+        for(int &number : numbers) number = 1 + next(12);
+        const int target = next(60);
+        mismatches += how_sum_arena(target, numbers) != how_sum_memo(target, numbers);
+        mismatches += best_sum_arena(target, numbers) != best_sum_memo(target, numbers);
+        
+        std::vector<std::string> word_bank(1 + next(5));
+        for(std::string &word : word_bank)
+            for(std::uint32_t k = 1 + next(3); k; --k) word += static_cast<char>('a' + next(2));
+        std::string word;
+        for(std::uint32_t k = next(14); k; --k) word += static_cast<char>('a' + next(2));
+        mismatches += all_construct_arena(word, word_bank) != all_construct_memo(word, word_bank);
+    }
+    std::cout << mismatches << '\n';    // 0
+}
+
+void test_memo_stack()
+{
+    // the *_memo answers on a heap stack, far deeper than the thread stack allows
+    std::cout << fib_stack(50) << '\n';    // 12'586'269'025
+    std::vector<int> numbers1 = { 3 };
+    std::cout << std::boolalpha << can_sum_stack(3'000'000, numbers1) << '\n';     // true, a million frames deep
+    std::vector<int> numbers2 = { 5, 3, 4, 7 };
+    printv(how_sum_stack(7, numbers2));     // {4, 3}
+    std::vector<int> numbers3 = { 1, 4, 5 };
+    printv(best_sum_stack(8, numbers3));    // {4, 4}
+    
+    std::vector<std::string> strs1 = { "a", "aa", "aaa" };
+    std::cout << can_construct_stack(std::string(1'000'000, 'a') + 'b', strs1) << '\n';     // false
+    std::cout << count_construct_stack(std::string(30, 'a'), strs1) << '\n';    // 53'798'080
+    std::vector<std::string> strs2 = { "ab", "abc", "cd", "def", "abcd" , "ef", "c"};
+    printv(all_construct_stack("abcdef", strs2));
+    // {
+    //     {ab, cd, ef},
+    //     {ab, c, def},
+    //     {abc, def},
+    //     {abcd, ef}
+    // }
+    
+    // one frame per reachable state, the same count as the recursion's calls
+    const SolverStats stack = collect_stats([&]{ can_construct_stack(std::string(20, 'a'), strs1); });
+    std::cout << stack.calls << ' ' << stack.max_depth << '\n';     // 20 20 with -DDP_STATS
+}
+
+//
+// DP SPECS
+//
+// the problems above described once for dp_spec.h, the combine operator picks which
+// question a spec answers and the framework writes the recursion, memo and table
+// how_sum's first path found has no combine of its own, it depends on the search order
+struct FibSpec
+{
+    using key_type = int;
+    using label_type = int;
+    using combine_type = DpCount<unsigned long long int>;
+    static constexpr DpDirection direction = DpDirection::down;
+
+    // fib(n) counts the ways down to 1 or 2 taking one or two at a time
+    bool goal(const int n) const { return n <= 2; }
+    std::size_t transitions(int) const { return 2; }
+    bool child(const int n, const std::size_t k, int &out) const
+    {
+        out = n - 1 - static_cast<int>(k);
+        return true;
+    }
+    bool parent(const int n, const std::size_t k, int &out) const
+    {
+        out = n + 1 + static_cast<int>(k);
+        return true;
+    }
+    int label(int, const std::size_t k) const { return static_cast<int>(k) + 1; }
+    std::size_t bound(const int n) const { return static_cast<std::size_t>(std::max(n, 0)) + 1; }
+};
+
+// no bound, the packed keys go into a hash memo
+struct GridTravelerSpec
+{
+    using key_type = std::uint64_t;
+    using label_type = int;
+    using combine_type = DpCount<unsigned int>;
+
+    bool goal(const std::uint64_t key) const { return key == pack_key(1, 1); }
+    std::size_t transitions(std::uint64_t) const { return 2; }
+    bool child(const std::uint64_t key, const std::size_t k, std::uint64_t &out) const
+    {
+        std::uint32_t x = static_cast<std::uint32_t>(key >> 32), y = static_cast<std::uint32_t>(key);
+        (k == 0 ? x : y) -= 1;
+        out = pack_key(x, y);
+        return x && y;
+    }
+    int label(std::uint64_t, const std::size_t k) const { return static_cast<int>(k); }
+};
+
+// a state is what is left of the target, transition k takes numbers[k]
+template<typename Combine>
+struct SumSpec
+{
+    using key_type = int;
+    using label_type = int;
+    using combine_type = Combine;
+    static constexpr DpDirection direction = DpDirection::down;
+
+    const std::vector<int> &numbers;
+
+    bool goal(const int target) const { return target == 0; }
+    std::size_t transitions(int) const { return numbers.size(); }
+    bool child(const int target, const std::size_t k, int &out) const
+    {
+        out = target - numbers[k];
+        return out >= 0;
+    }
+    bool parent(const int target, const std::size_t k, int &out) const
+    {
+        out = target + numbers[k];
+        return true;
+    }
+    int label(int, const std::size_t k) const { return numbers[k]; }
+    std::size_t bound(const int target) const { return static_cast<std::size_t>(std::max(target, 0)) + 1; }
+};
+
+// a state is an offset into target, transition k takes word k if the rest starts with it
+template<typename Combine>
+struct ConstructSpec
+{
+    using key_type = std::size_t;
+    using label_type = std::string_view;
+    using combine_type = Combine;
+    static constexpr DpDirection direction = DpDirection::up;
+
+    std::string_view target;
+    const std::vector<std::string> &word_bank;
+
+    bool goal(const std::size_t offset) const { return offset == target.size(); }
+    std::size_t transitions(std::size_t) const { return word_bank.size(); }
+    bool child(const std::size_t offset, const std::size_t k, std::size_t &out) const
+    {
+        const std::string &word = word_bank[k];
+        out = offset + word.size();
+        return !word.empty() && target.substr(offset).starts_with(word);
+    }
+    bool parent(const std::size_t offset, const std::size_t k, std::size_t &out) const
+    {
+        const std::string &word = word_bank[k];
+        if(word.empty() || word.size() > offset) return false;
+        out = offset - word.size();
+        return target.substr(out).starts_with(word);
+    }
+    std::string_view label(std::size_t, const std::size_t k) const { return word_bank[k]; }
+    std::size_t bound(std::size_t) const { return target.size() + 1; }
+};
+
+// the generated variants, in the signatures of the hand written ones
+unsigned long long int fib_spec(const int &n)
+{
+    return dp_memo(FibSpec{}, n);
+}
+
+unsigned int grid_traveler_spec(const int &x, const int &y)
+{
+    if(x <= 0 || y <= 0) return 0;
+    return dp_memo(GridTravelerSpec{}, pack_key(x, y));
+}
+
+bool can_sum_spec(const int &target, const std::vector<int> &numbers)
+{
+    if(target < 0) return false;
+    return dp_tab(SumSpec<DpOr>{numbers}, target, DpOrder::push);
+}
+
+std::vector<int> best_sum_spec(const int &target, const std::vector<int> &numbers)
+{
+    if(target < 0) return { 0 };
+    std::optional<std::vector<int>> shortest = dp_tab(SumSpec<DpMinLength<int, DpPath::backward>>{numbers}, target);
+    return shortest ? std::move(*shortest) : std::vector<int>{ 0 };
+}
+
+int count_construct_spec(const std::string &target, const std::vector<std::string> &word_bank)
+{
+    return dp_tab(ConstructSpec<DpCount<int>>{target, word_bank}, 0);
+}
+
+std::vector<std::vector<std::string>> all_construct_spec(const std::string &target, const std::vector<std::string> &word_bank)
+{
+    const std::vector<std::vector<std::string_view>> ways = dp_memo(ConstructSpec<DpEnumerate<std::string_view>>{target, word_bank}, 0);
+    std::vector<std::vector<std::string>> result;
+    result.reserve(ways.size());
+    for(const std::vector<std::string_view> &way : ways)
+        result.emplace_back(way.begin(), way.end());
+    return result;
+}
+
+void test_dp_spec()
+{
+    // one spec, four questions
+    std::vector<int> numbers = { 1, 4, 5 };
+    std::cout << std::boolalpha << dp_memo(SumSpec<DpOr>{numbers}, 8) << '\n';     // true
+    std::cout << dp_tab(SumSpec<DpCount<int>>{numbers}, 8, DpOrder::push) << '\n';   // 11, order matters
+    printv(*dp_tab(SumSpec<DpMinLength<int, DpPath::backward>>{numbers}, 8));        // {4, 4}
+    std::cout << dp_recu(SumSpec<DpEnumerate<int>>{numbers}, 8).size() << '\n';     // 11
+    
+    // the generated variants answer the hand written tests
+    std::cout << fib(50, fib_spec) << '\n';     // 12'586'269'025
+    std::cout << grid_traveler(18, 18, grid_traveler_spec) << '\n';    // 2'333'606'220
+    std::vector<int> numbers2 = { 7, 14 };
+    std::cout << can_sum(300, numbers2, can_sum_spec) << '\n';     // false
+    std::vector<int> numbers3 = { 25, 1, 5, 2 };
+    std::cout << best_sum(100, numbers3, best_sum_spec).size() << '\n';    // 4
+    std::vector<std::string> strs1 = { "a", "p", "ent", "enter", "ot", "o", "t" };
+    std::cout << count_construct("enterapotentpot", strs1, count_construct_spec) << '\n';   // 4
+    std::vector<std::string> strs2 = { "ab", "abc", "cd", "def", "abcd" , "ef", "c"};
+    printv(all_construct_spec("abcdef", strs2));
+    // {
+    //     {ab, cd, ef},
+    //     {ab, c, def},
+    //     {abc, def},
+    //     {abcd, ef}
+    // }
+}
+
+// src/bench.cpp includes this file for the solvers and brings its own main
+#ifndef DP_NO_MAIN
 int main()
 {
     test_all_construct(&all_construct_memo);
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,210 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "stats.h"
+//
+// MEMO POLICIES
+//
+// every *_memo function is templated on one of these, a policy provides
+//     const V* find(const K &key) const    nullptr on a miss
+//     V& store(const K &key, V value)
+// pointers returned by find are only valid until the next store
+// with DP_STATS the policies count hits, misses, entries and the bytes of their storage
+//
+
+// two 32 bit coordinates in a single 64 bit key, no heap allocated std::vector key
+constexpr std::uint64_t pack_key(const std::uint32_t x, const std::uint32_t y)
+{
+    return (static_cast<std::uint64_t>(x) << 32) | y;
+}
+//
+// MAP MEMO
+//
+// node based std::map, what the memo functions originally used
+template<typename K, typename V>
+class MapMemo
+{
+public:
+    const V* find(const K &key) const
+    {
+        const auto it = map_.find(key);
+        const V *value = it == map_.end() ? nullptr : &it->second;
+        DP_STATS_MEMO(value);
+        return value;
+    }
+
+    V& store(const K &key, V value)
+    {
+        const auto [it, inserted] = map_.insert_or_assign(key, std::move(value));
+        if(inserted) DP_STATS_BYTES(sizeof(typename std::map<K, V>::value_type));
+        DP_STATS_ENTRIES(map_.size());
+        return it->second;
+    }
+
+    std::size_t size() const { return map_.size(); }
+
+private:
+    std::map<K, V> map_;
+};
+//
+// DENSE MEMO
+//
+// bounded non-negative integer keys index a flat array, a lookup is a single load
+template<typename V>
+class DenseMemo
+{
+public:
+    explicit DenseMemo(const std::size_t bound = 0) : slots_(bound) { DP_STATS_BYTES(bound * sizeof(Slot)); }
+
+    template<typename K>
+    const V* find(const K key) const
+    {
+        const V *value = nullptr;
+        if(!(std::is_signed_v<K> && key < 0) && static_cast<std::size_t>(key) < slots_.size()){
+            const Slot &slot = slots_[static_cast<std::size_t>(key)];
+            if(slot.known) value = &slot.value;
+        }
+        DP_STATS_MEMO(value);
+        return value;
+    }
+
+    template<typename K>
+    V& store(const K key, V value)
+    {
+        const std::size_t index = static_cast<std::size_t>(key);
+        if(index >= slots_.size()){
+            DP_STATS_BYTES((index + 1 - slots_.size()) * sizeof(Slot));
+            slots_.resize(index + 1);
+        }
+        Slot &slot = slots_[index];
+        size_ += !slot.known;
+        DP_STATS_ENTRIES(size_);
+        slot.value = std::move(value);
+        slot.known = true;
+        return slot.value;
+    }
+
+    std::size_t size() const { return size_; }
+
+private:
+    struct Slot
+    {
+        V value{};
+        bool known = false;
+    };
+    std::vector<Slot> slots_;
+    std::size_t size_ = 0;
+};
+//
+// FLAT HASH MEMO
+//
+// open addressing with linear probing for sparse keys, keys and values live inline in one array
+template<typename K>
+struct MemoHash
+{
+    std::size_t operator()(const K &key) const { return std::hash<K>{}(key); }
+};
+
+template<>
+struct MemoHash<std::uint64_t>
+{
+    std::size_t operator()(std::uint64_t key) const
+    {
+        // splitmix64 finalizer, packed keys differ mostly in the high bits
+        key ^= key >> 30;
+        key *= 0xbf58476d1ce4e5b9ull;
+        key ^= key >> 27;
+        key *= 0x94d049bb133111ebull;
+        key ^= key >> 31;
+        return static_cast<std::size_t>(key);
+    }
+};
+
+template<>
+struct MemoHash<int>
+{
+    std::size_t operator()(const int key) const
+    {
+        return MemoHash<std::uint64_t>{}(static_cast<std::uint64_t>(static_cast<std::uint32_t>(key)));
+    }
+};
+
+template<typename K, typename V, typename Hash = MemoHash<K>>
+class FlatHashMemo
+{
+public:
+    explicit FlatHashMemo(const std::size_t expected = 0)
+    {
+        std::size_t capacity = 16;
+        while(capacity < 2 * expected) capacity *= 2;
+        slots_.resize(capacity);
+        DP_STATS_BYTES(capacity * sizeof(Slot));
+    }
+
+    const V* find(const K &key) const
+    {
+        const std::size_t mask = slots_.size() - 1;
+        for(std::size_t i = Hash{}(key) & mask;; i = (i + 1) & mask){
+            const Slot &slot = slots_[i];
+            if(!slot.used || slot.key == key){
+                const V *value = slot.used ? &slot.value : nullptr;
+                DP_STATS_MEMO(value);
+                return value;
+            }
+        }
+    }
+
+    V& store(const K &key, V value)
+    {
+        // keeps the load factor at or below 1/2
+        if(2 * (size_ + 1) > slots_.size()) rehash(2 * slots_.size());
+        Slot &slot = probe(key);
+        if(!slot.used){
+            slot.used = true;
+            slot.key = key;
+            ++size_;
+            DP_STATS_ENTRIES(size_);
+        }
+        slot.value = std::move(value);
+        return slot.value;
+    }
+
+    std::size_t size() const { return size_; }
+
+private:
+    struct Slot
+    {
+        K key{};
+        V value{};
+        bool used = false;
+    };
+    std::vector<Slot> slots_;
+    std::size_t size_ = 0;
+
+    Slot& probe(const K &key)
+    {
+        const std::size_t mask = slots_.size() - 1;
+        for(std::size_t i = Hash{}(key) & mask;; i = (i + 1) & mask){
+            Slot &slot = slots_[i];
+            if(!slot.used || slot.key == key) return slot;
+        }
+    }
+
+    void rehash(const std::size_t capacity)
+    {
+        std::vector<Slot> old(capacity);
+        DP_STATS_BYTES(capacity * sizeof(Slot));
+        old.swap(slots_);
+        for(Slot &slot : old){
+            if(slot.used){
+                Slot &moved = probe(slot.key);
+                moved = std::move(slot);
+            }
+        }
+    }
+};
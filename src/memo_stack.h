@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "stats.h"
+//
+// EXPLICIT STACK MEMOIZATION
+//
+// the top down evaluation of a *_memo function with the call stack moved to the heap:
+// a frame is a state waiting on the transition it is at, only states reached from the
+// root are visited, in the same order the recursion visits them, and the depth is
+// limited by memory instead of the thread stack
+// a problem provides
+//     key_type, value_type, state_type       a state, its answer and a partial answer
+//     bool base(key, value_type &out) const   answers key without the memo, true if it did
+//     state_type start(key) const             the partial answer before any transition
+//     std::size_t transitions(key) const
+//     bool child(key, k, key_type &out) const the key transition k leads to, false if it leads nowhere
+//     bool fold(key, k, state_type&, const value_type &child) const
+//                                             adds the answer of transition k, false stops early
+//     value_type finish(key, state_type&&) const
+// keys must not lead back to themselves, a cycle never finishes here either, and a
+// problem can't start another evaluation of its own type from inside one
+template<typename Problem, typename Memo>
+typename Problem::value_type memo_stack_solve(const Problem &problem, const typename Problem::key_type &root, Memo &memo)
+{
+    using Key = typename Problem::key_type;
+    using Value = typename Problem::value_type;
+    using State = typename Problem::state_type;
+    struct Frame
+    {
+        Key key;
+        State state;
+        std::size_t next;    // transition to try next, the one being waited on is next - 1
+        bool done;
+    };
+
+    Value value;
+    if(problem.base(root, value)) return value;
+    if(const Value *hit = memo.find(root)) return *hit;
+
+    // kept between calls, its pages stay mapped like the thread stack's do
+    static thread_local std::vector<Frame> stack;
+    stack.clear();
+    stack.push_back({ root, problem.start(root), 0, false });
+    DP_STATS_FRAME(1);
+    while(true){
+        Frame &frame = stack.back();
+        Key key{};
+        bool descend = false;
+        while(!frame.done && frame.next < problem.transitions(frame.key)){
+            const std::size_t k = frame.next++;
+            if(!problem.child(frame.key, k, key)) continue;
+            const Value *known = problem.base(key, value) ? &value : memo.find(key);
+            if(!known){
+                descend = true;
+                break;
+            }
+            frame.done = !problem.fold(frame.key, k, frame.state, *known);
+        }
+        if(descend){
+            // frame dangles past here, the push may move the stack
+            State state = problem.start(key);
+            stack.push_back({ std::move(key), std::move(state), 0, false });
+            DP_STATS_FRAME(stack.size());
+            continue;
+        }
+
+        key = std::move(frame.key);
+        value = problem.finish(key, std::move(frame.state));
+        stack.pop_back();
+        const Value &answer = memo.store(key, std::move(value));
+        if(stack.empty()) return answer;
+        Frame &parent = stack.back();
+        parent.done = !problem.fold(parent.key, parent.next - 1, parent.state, answer);
+    }
+}
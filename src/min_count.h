@@ -0,0 +1,119 @@
+#pragma once
+#include <algorithm>
+#include <barrier>
+#include <climits>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include "simd.h"
+//
+// MIN COUNT KERNEL
+//
+// dp[i] = min(dp[i - c] + 1) over the numbers c, the unbounded minimum coin count
+// cells in [b, b + min(numbers)) only read cells below b, so each block is filled
+// coin by coin as one contiguous vector min, and split between threads when it is wide
+
+constexpr int min_count_unreachable = INT_MAX / 2;
+
+// cells a thread gets per block before it is worth waking another one
+constexpr int min_count_parallel_cells = 1 << 14;
+
+// dst[k] = min(dst[k], src[k] + 1), the ranges don't overlap
+using min_plus_one_kernel = void(*)(int *dst, const int *src, std::size_t n);
+
+inline void min_plus_one_scalar(int *dst, const int *src, const std::size_t n)
+{
+    for(std::size_t k = 0; k < n; ++k)
+        dst[k] = std::min(dst[k], src[k] + 1);
+}
+
+#if DP_X86_DISPATCH
+DP_TARGET_AVX2 inline void min_plus_one_avx2(int *dst, const int *src, const std::size_t n)
+{
+    const __m256i one = _mm256_set1_epi32(1);
+    std::size_t k = 0;
+    for(; k + 8 <= n; k += 8){
+        const __m256i from = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + k)), one);
+        __m256i *to = reinterpret_cast<__m256i*>(dst + k);
+        _mm256_storeu_si256(to, _mm256_min_epi32(_mm256_loadu_si256(to), from));
+    }
+    for(; k < n; ++k)
+        dst[k] = std::min(dst[k], src[k] + 1);
+}
+
+// gcc 12 headers trip -Wmaybe-uninitialized inside the avx-512 intrinsics
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+DP_TARGET_AVX512 inline void min_plus_one_avx512(int *dst, const int *src, const std::size_t n)
+{
+    const __m512i one = _mm512_set1_epi32(1);
+    std::size_t k = 0;
+    for(; k + 16 <= n; k += 16){
+        const __m512i from = _mm512_add_epi32(_mm512_loadu_si512(src + k), one);
+        _mm512_storeu_si512(dst + k, _mm512_min_epi32(_mm512_loadu_si512(dst + k), from));
+    }
+    for(; k < n; ++k)
+        dst[k] = std::min(dst[k], src[k] + 1);
+}
+#pragma GCC diagnostic pop
+#endif
+
+inline min_plus_one_kernel select_min_plus_one_kernel()
+{
+#if DP_X86_DISPATCH
+    if(cpu_has_avx512()) return min_plus_one_avx512;
+    if(cpu_has_avx2()) return min_plus_one_avx2;
+#endif
+    return min_plus_one_scalar;
+}
+
+// fills dp[lo, hi) from the cells below lo, coins sorted ascending
+inline void min_count_range(int *dp, const std::vector<int> &coins, const int lo, const int hi)
+{
+    static const min_plus_one_kernel kernel = select_min_plus_one_kernel();
+    for(int c : coins){
+        if(c >= hi) break;
+        const int from = std::max(lo, c);
+        kernel(dp + from, dp + from - c, hi - from);
+    }
+}
+
+// minimum number of terms for every sum in [0, target], min_count_unreachable when there is none
+inline std::vector<int> min_count_table(const int target, std::vector<int> numbers, unsigned threads = 0)
+{
+    // O(m*n / lanes / threads) time
+    // O(m) space
+    std::vector<int> dp(target + 1, min_count_unreachable);
+    dp[0] = 0;
+    numbers.erase(std::remove_if(numbers.begin(), numbers.end(), [&](int num){ return num <= 0 || num > target; }), numbers.end());
+    if(numbers.empty()) return dp;
+    std::sort(numbers.begin(), numbers.end());
+    numbers.erase(std::unique(numbers.begin(), numbers.end()), numbers.end());
+
+    const int width = numbers.front();
+    if(!threads) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<unsigned>(threads, std::max(1, width / min_count_parallel_cells));
+
+    if(threads == 1){
+        for(long long block = 1; block <= target; block += width)
+            min_count_range(dp.data(), numbers, static_cast<int>(block), static_cast<int>(std::min(block + width, target + 1ll)));
+        return dp;
+    }
+
+    std::barrier sync(threads);
+    auto worker = [&](const unsigned t){
+        for(long long block = 1; block <= target; block += width){
+            const long long end = std::min(block + width, target + 1ll);
+            const long long len = end - block;
+            const int lo = static_cast<int>(block + len * t / threads);
+            const int hi = static_cast<int>(block + len * (t + 1) / threads);
+            min_count_range(dp.data(), numbers, lo, hi);
+            sync.arrive_and_wait();
+        }
+    };
+    std::vector<std::thread> pool;
+    for(unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for(std::thread &thread : pool) thread.join();
+    return dp;
+}
@@ -0,0 +1,199 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+//
+// MODULAR RINGS
+//
+// residues mod m behind one interface, so a loop written once runs with whichever
+// reduction fits m, a ring provides
+//     std::uint64_t in(x) const       a residue into the ring's own form
+//     std::uint64_t out(x) const      and back
+//     std::uint64_t add(a, b) const, sub(a, b) const, mul(a, b) const
+// the 128 bit products need the gcc and clang unsigned __int128
+using uint128 = unsigned __int128;
+
+// bits up to the highest set one, 0 for 0
+inline int bit_width_128(const uint128 x)
+{
+    const std::uint64_t high = static_cast<std::uint64_t>(x >> 64);
+    return high ? 64 + std::bit_width(high) : std::bit_width(static_cast<std::uint64_t>(x));
+}
+
+// m < 2^32, a product fits in 64 bits and mu = floor((2^64 - 1) / m) gets the quotient
+// within one, so a reduction is a high multiply, a multiply and one compare
+struct BarrettMod
+{
+    std::uint64_t m = 1, mu = ~std::uint64_t(0);
+
+    BarrettMod() = default;
+    explicit BarrettMod(const std::uint64_t m) : m(m), mu(~std::uint64_t(0) / m) {}
+
+    std::uint64_t reduce(const std::uint64_t x) const
+    {
+        const std::uint64_t q = static_cast<std::uint64_t>((static_cast<uint128>(x) * mu) >> 64);
+        const std::uint64_t r = x - q * m;
+        return r >= m ? r - m : r;
+    }
+
+    std::uint64_t in(const std::uint64_t x) const { return x % m; }
+    std::uint64_t out(const std::uint64_t x) const { return x; }
+    std::uint64_t add(const std::uint64_t a, const std::uint64_t b) const { const std::uint64_t s = a + b; return s >= m ? s - m : s; }
+    std::uint64_t sub(const std::uint64_t a, const std::uint64_t b) const { return a >= b ? a - b : a + m - b; }
+    std::uint64_t mul(const std::uint64_t a, const std::uint64_t b) const { return reduce(a * b); }
+};
+
+// odd m < 2^64, residues kept as x * 2^64 mod m so a product reduces with two multiplies
+// and a subtraction instead of a 128 bit division
+struct MontgomeryMod
+{
+    std::uint64_t m = 1, inverse = 1, r2 = 0;    // m * inverse = 1 mod 2^64, r2 = 2^128 mod m
+
+    MontgomeryMod() = default;
+    explicit MontgomeryMod(const std::uint64_t m) : m(m), inverse(m)
+    {
+        // each newton step doubles the correct low bits, m is its own inverse mod 8
+        for(int step = 0; step < 5; ++step) inverse *= 2 - m * inverse;
+        const std::uint64_t r = static_cast<std::uint64_t>((static_cast<uint128>(1) << 64) % m);
+        r2 = static_cast<std::uint64_t>(static_cast<uint128>(r) * r % m);
+    }
+
+    // t / 2^64 mod m for t < m * 2^64, the low halves of t and q * m cancel
+    std::uint64_t reduce(const uint128 t) const
+    {
+        const std::uint64_t q = static_cast<std::uint64_t>(t) * inverse;
+        const std::uint64_t high = static_cast<std::uint64_t>((static_cast<uint128>(q) * m) >> 64);
+        const std::uint64_t top = static_cast<std::uint64_t>(t >> 64);
+        return top >= high ? top - high : top + (m - high);
+    }
+
+    std::uint64_t in(const std::uint64_t x) const { return reduce(static_cast<uint128>(x % m) * r2); }
+    std::uint64_t out(const std::uint64_t x) const { return reduce(x); }
+    // a + b may pass 2^64, compared against m - b it can't, and one compare becomes a cmov
+    std::uint64_t add(const std::uint64_t a, const std::uint64_t b) const
+    {
+        const std::uint64_t gap = m - b;
+        return a >= gap ? a - gap : a + b;
+    }
+    std::uint64_t sub(const std::uint64_t a, const std::uint64_t b) const { return a >= b ? a - b : a + (m - b); }
+    std::uint64_t mul(const std::uint64_t a, const std::uint64_t b) const { return reduce(static_cast<uint128>(a) * b); }
+};
+
+// m = 2^k, k < 64, the machine wraps mod 2^64 already and a mask does the rest
+struct PowerOfTwoMod
+{
+    std::uint64_t mask = 0;
+
+    PowerOfTwoMod() = default;
+    explicit PowerOfTwoMod(const int k) : mask((std::uint64_t(1) << k) - 1) {}
+
+    std::uint64_t in(const std::uint64_t x) const { return x & mask; }
+    std::uint64_t out(const std::uint64_t x) const { return x; }
+    std::uint64_t add(const std::uint64_t a, const std::uint64_t b) const { return (a + b) & mask; }
+    std::uint64_t sub(const std::uint64_t a, const std::uint64_t b) const { return (a - b) & mask; }
+    std::uint64_t mul(const std::uint64_t a, const std::uint64_t b) const { return (a * b) & mask; }
+};
+//
+// FACTORING
+//
+// 64 bit numbers into primes, miller rabin with the bases that are exact below 2^64 and
+// brent's variant of pollard's rho, a few microseconds for one modulus
+inline std::uint64_t mul_mod(const std::uint64_t a, const std::uint64_t b, const std::uint64_t m)
+{
+    return static_cast<std::uint64_t>(static_cast<uint128>(a) * b % m);
+}
+
+inline std::uint64_t pow_mod(std::uint64_t base, std::uint64_t exponent, const std::uint64_t m)
+{
+    std::uint64_t result = 1 % m;
+    base %= m;
+    for(; exponent; exponent >>= 1){
+        if(exponent & 1) result = mul_mod(result, base, m);
+        base = mul_mod(base, base, m);
+    }
+    return result;
+}
+
+inline bool is_prime(const std::uint64_t n)
+{
+    if(n < 2) return false;
+    for(std::uint64_t p : { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 })
+        if(n % p == 0) return n == p;
+    const int s = std::countr_zero(n - 1);
+    const std::uint64_t d = (n - 1) >> s;
+    for(std::uint64_t a : { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 }){
+        std::uint64_t x = pow_mod(a, d, n);
+        if(x == 1 || x == n - 1) continue;
+        bool composite = true;
+        for(int r = 1; r < s && composite; ++r){
+            x = mul_mod(x, x, n);
+            composite = x != n - 1;
+        }
+        if(composite) return false;
+    }
+    return true;
+}
+
+// a non trivial factor of an odd composite n
+inline std::uint64_t pollard_brent(const std::uint64_t n)
+{
+    for(std::uint64_t c = 1;; ++c){
+        const auto f = [&](const std::uint64_t x){ return static_cast<std::uint64_t>((static_cast<uint128>(mul_mod(x, x, n)) + c) % n); };
+        std::uint64_t y = 2, x = 2, ys = 2, q = 1, g = 1;
+        // products of 128 differences share one gcd
+        for(std::uint64_t r = 1; g == 1; r *= 2){
+            x = y;
+            for(std::uint64_t i = 0; i < r; ++i) y = f(y);
+            for(std::uint64_t k = 0; k < r && g == 1; k += 128){
+                ys = y;
+                for(std::uint64_t i = 0; i < std::min<std::uint64_t>(128, r - k); ++i){
+                    y = f(y);
+                    q = mul_mod(q, x > y ? x - y : y - x, n);
+                }
+                g = std::gcd(q, n);
+            }
+        }
+        if(g == n){
+            // the batch overshot, step back one difference at a time
+            do{
+                ys = f(ys);
+                g = std::gcd(x > ys ? x - ys : ys - x, n);
+            }while(g == 1);
+        }
+        if(g != n) return g;
+    }
+}
+
+// prime, exponent pairs in ascending prime order
+inline std::vector<std::pair<std::uint64_t, int>> factorize(std::uint64_t n)
+{
+    std::vector<std::uint64_t> primes;
+    for(std::uint64_t p = 2; p < 100 && p * p <= n; ++p)
+        while(n % p == 0){
+            primes.push_back(p);
+            n /= p;
+        }
+    std::vector<std::uint64_t> pending;
+    if(n > 1) pending.push_back(n);
+    while(!pending.empty()){
+        const std::uint64_t x = pending.back();
+        pending.pop_back();
+        if(is_prime(x)){
+            primes.push_back(x);
+            continue;
+        }
+        const std::uint64_t d = pollard_brent(x);
+        pending.push_back(d);
+        pending.push_back(x / d);
+    }
+    std::sort(primes.begin(), primes.end());
+    std::vector<std::pair<std::uint64_t, int>> factors;
+    for(std::uint64_t p : primes){
+        if(!factors.empty() && factors.back().first == p) ++factors.back().second;
+        else factors.emplace_back(p, 1);
+    }
+    return factors;
+}
@@ -1,59 +1,311 @@
 #pragma once
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
+#include <unistd.h>
+//
+// OUTPUT BUFFER
+//
+// formatted bytes pile up in one reusable buffer and leave in large writes to a file
+// descriptor, a FILE* or an ostream, nothing is flushed until the buffer fills, flush()
+// is called or the buffer goes away
+class OutputBuffer
+{
+public:
+    explicit OutputBuffer(const int fd, const std::size_t capacity = 1 << 16) : fd_(fd) { buffer_.reserve(capacity); }
+    explicit OutputBuffer(std::FILE *file, const std::size_t capacity = 1 << 16) : file_(file) { buffer_.reserve(capacity); }
+    explicit OutputBuffer(std::ostream &stream, const std::size_t capacity = 1 << 16) : stream_(&stream) { buffer_.reserve(capacity); }
+    ~OutputBuffer() { flush(); }
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    void put(const char c)
+    {
+        if(buffer_.size() == buffer_.capacity()) flush();
+        buffer_.push_back(c);
+    }
+
+    void put(const std::string_view bytes)
+    {
+        if(buffer_.size() + bytes.size() > buffer_.capacity()) flush();
+        if(bytes.size() > buffer_.capacity()) send(bytes.data(), bytes.size());
+        else buffer_.insert(buffer_.end(), bytes.begin(), bytes.end());
+    }
+
+    // decimal through std::to_chars, doubles like an ostream's default %g with 6 digits
+    template<typename T>
+    void put_number(const T value)
+    {
+        char digits[32];
+        std::to_chars_result end;
+        if constexpr(std::is_floating_point_v<T>) end = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 6);
+        else end = std::to_chars(digits, digits + sizeof(digits), value);
+        put(std::string_view(digits, end.ptr - digits));
+    }
+
+    // a bool or number as operator<< would show it on the target stream, its flags,
+    // precision, fill and locale included; a stream left at its defaults, an fd or a
+    // FILE* take the to_chars path, bools as 1 and 0
+    template<typename T>
+    void put_formatted(const T value)
+    {
+        if(stream_ && !plain_format(*stream_)){
+            std::ostringstream text;
+            text.flags(stream_->flags());
+            text.precision(stream_->precision());
+            text.fill(stream_->fill());
+            text.imbue(stream_->getloc());
+            text << value;
+            put(text.str());
+        }
+        else if constexpr(std::is_same_v<T, bool>) put(value ? '1' : '0');
+        else put_number(value);
+    }
+
+    // the raw bytes of value, host byte order
+    template<typename T>
+    void put_raw(const T value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        put(std::string_view(bytes, sizeof(T)));
+    }
+
+    void flush()
+    {
+        if(!buffer_.empty()) send(buffer_.data(), buffer_.size());
+        buffer_.clear();
+    }
+
+private:
+    int fd_ = -1;
+    std::FILE *file_ = nullptr;
+    std::ostream *stream_ = nullptr;
+    std::vector<char> buffer_;
+
+    // flags, precision and locale as a fresh stream has them
+    static bool plain_format(const std::ostream &stream)
+    {
+        return stream.flags() == (std::ios_base::skipws | std::ios_base::dec) && stream.precision() == 6
+            && stream.getloc() == std::locale::classic();
+    }
+
+    void send(const char *data, std::size_t size)
+    {
+        if(stream_){
+            stream_->write(data, size);
+            return;
+        }
+        if(file_){
+            std::fwrite(data, 1, size, file_);
+            return;
+        }
+        while(size){
+            const ssize_t written = ::write(fd_, data, size);
+            if(written <= 0) return;
+            data += written;
+            size -= written;
+        }
+    }
+};
+//
+// FORMATS
+//
+// text is what printv shows, bools and numbers formatted like operator<< on the target
+// stream, ndjson is one json array per record and line, binary is
+//     integer, floating     8 bytes, int64_t or double
+//     bool, char            1 byte
+//     string                uint32_t length, then the bytes
+//     vector                uint32_t element count, then the elements
+// in host byte order; types only printable through operator<<, like BigUint, go
+// as their text, a string in json and binary
+enum class OutputMode { text, ndjson, binary };
+
+template<typename T>
+struct is_vector : std::false_type {};
+
+template<typename T>
+struct is_vector<std::vector<T>> : std::true_type {};
+
+template<typename T>
+constexpr bool is_char_v = std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>;
+
+template<typename T>
+constexpr bool is_number_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !is_char_v<T>;
+
+template<typename T>
+std::string stream_text(const T &value)
+{
+    std::ostringstream text;
+    text << value;
+    return text.str();
+}
+
+template<typename T>
+void write_text(OutputBuffer &out, const T &value, const int indent = 0)
+{
+    if constexpr(is_vector<T>::value){
+        using E = typename T::value_type;
+        if constexpr(is_vector<E>::value){
+            // one element per line, each a level deeper
+            out.put("{\n");
+            for(std::size_t i = 0; i < value.size(); ++i){
+                for(int k = 0; k <= indent; ++k) out.put("    ");
+                write_text(out, static_cast<const E&>(value[i]), indent + 1);
+                if(i + 1 < value.size()) out.put(", \n");
+            }
+            out.put('\n');
+            for(int k = 0; k < indent; ++k) out.put("    ");
+            out.put('}');
+        }
+        else{
+            out.put('{');
+            for(std::size_t i = 0; i < value.size(); ++i){
+                if(i) out.put(", ");
+                write_text(out, static_cast<const E&>(value[i]), indent);
+            }
+            out.put('}');
+        }
+    }
+    else if constexpr(is_char_v<T>) out.put(static_cast<char>(value));
+    else if constexpr(std::is_same_v<T, bool> || is_number_v<T>) out.put_formatted(value);
+    else if constexpr(std::is_convertible_v<const T&, std::string_view>) out.put(std::string_view(value));
+    else out.put(stream_text(value));
+}
+
+inline void write_json_string(OutputBuffer &out, const std::string_view text)
+{
+    out.put('"');
+    for(const char c : text){
+        switch(c){
+        case '"': out.put("\\\""); break;
+        case '\\': out.put("\\\\"); break;
+        case '\n': out.put("\\n"); break;
+        case '\t': out.put("\\t"); break;
+        case '\r': out.put("\\r"); break;
+        default:
+            if(static_cast<unsigned char>(c) < 0x20){
+                constexpr char hex[] = "0123456789abcdef";
+                out.put("\\u00");
+                out.put(hex[(c >> 4) & 0xf]);
+                out.put(hex[c & 0xf]);
+            }
+            else out.put(c);
+        }
+    }
+    out.put('"');
+}
+
+template<typename T>
+void write_json(OutputBuffer &out, const T &value)
+{
+    if constexpr(is_vector<T>::value){
+        using E = typename T::value_type;
+        out.put('[');
+        for(std::size_t i = 0; i < value.size(); ++i){
+            if(i) out.put(',');
+            if constexpr(is_vector<E>::value) write_json(out, value[i]);
+            else write_json(out, static_cast<const E&>(value[i]));
+        }
+        out.put(']');
+    }
+    else if constexpr(std::is_same_v<T, bool>) out.put(value ? "true" : "false");
+    else if constexpr(is_char_v<T>) write_json_string(out, std::string_view(reinterpret_cast<const char*>(&value), 1));
+    else if constexpr(is_number_v<T>) out.put_number(value);
+    else if constexpr(std::is_convertible_v<const T&, std::string_view>) write_json_string(out, std::string_view(value));
+    else write_json_string(out, stream_text(value));
+}
+
+template<typename T>
+void write_binary(OutputBuffer &out, const T &value)
+{
+    if constexpr(is_vector<T>::value){
+        using E = typename T::value_type;
+        out.put_raw(static_cast<std::uint32_t>(value.size()));
+        for(std::size_t i = 0; i < value.size(); ++i){
+            if constexpr(is_vector<E>::value) write_binary(out, value[i]);
+            else write_binary(out, static_cast<const E&>(value[i]));
+        }
+    }
+    else if constexpr(std::is_same_v<T, bool> || is_char_v<T>) out.put(static_cast<char>(value));
+    else if constexpr(std::is_floating_point_v<T>) out.put_raw(static_cast<double>(value));
+    else if constexpr(std::is_integral_v<T>) out.put_raw(static_cast<std::int64_t>(value));
+    else if constexpr(std::is_convertible_v<const T&, std::string_view>){
+        const std::string_view bytes(value);
+        out.put_raw(static_cast<std::uint32_t>(bytes.size()));
+        out.put(bytes);
+    }
+    else write_binary(out, stream_text(value));
+}
+
+// one record, text and ndjson end it with a newline
+template<typename T>
+void write_record(OutputBuffer &out, const T &value, const OutputMode mode = OutputMode::text)
+{
+    switch(mode){
+    case OutputMode::text: write_text(out, value); out.put('\n'); break;
+    case OutputMode::ndjson: write_json(out, value); out.put('\n'); break;
+    case OutputMode::binary: write_binary(out, value); break;
+    }
+}
+
+// a record per element, all_construct results as one construction per line
+template<typename T>
+void write_records(OutputBuffer &out, const std::vector<T> &values, const OutputMode mode = OutputMode::text)
+{
+    for(const T &value : values) write_record(out, value, mode);
+}
 //
 // PRINT VECTOR
 //
+// each call formats the whole vector into a buffer kept between calls and hands it to
+// std::cout in one write, a newline ends it without flushing
+inline OutputBuffer& printv_buffer()
+{
+    static thread_local OutputBuffer out(std::cout, 1 << 12);
+    return out;
+}
+
 template<typename T>
 void printv(const std::vector<T> &vector, const bool endline = true)
 {
     // 1D vector
-    const int v_size = vector.size();    // size of the vector
-    
-    std::cout << '{';
-    for(int i = 0; i < v_size; ++i){
-        std::cout << vector[i];
-        if(i < v_size - 1)   // put comma until the last element
-            std::cout << ", ";
-    }
-    std::cout << '}';
-    if(endline) std::cout << std::endl;
+    OutputBuffer &out = printv_buffer();
+    write_text(out, vector);
+    if(endline) out.put('\n');
+    out.flush();
 }
 
 template<typename T>
 void printv(const std::vector<std::vector<T>> &vector, const bool endline = true, const bool extra_indent = false)
 {
     // 2D vector
-    const int v_size = vector.size();        // size of the vector
-    
-    if(extra_indent) std::cout << "    ";
-    std::cout << "{\n";
-    for(int i = 0; i < v_size; ++i){
-        if(extra_indent) std::cout << "    ";
-        std::cout << "    ";
-        printv(vector[i], false);
-        if(i < v_size - 1)   // put comma and \n until the last element
-            std::cout << ", \n";
-    }
-    std::cout << '\n';
-    if(extra_indent) std::cout << "    ";
-    std::cout << '}';
-    if(endline) std::cout << std::endl;
+    OutputBuffer &out = printv_buffer();
+    if(extra_indent) out.put("    ");
+    write_text(out, vector, extra_indent);
+    if(endline) out.put('\n');
+    out.flush();
 }
 
 template<typename T>
 void printv(const std::vector<std::vector<std::vector<T>>> &vector)
 {
     // 3D vector
-    const int v_size = vector.size();        // size of the vector
-    
-    std::cout << "{\n";
-    for(int i = 0; i < v_size; ++i){
-        printv(vector[i], false, true);
-        if(i < v_size - 1)   // put comma until the last element
-            std::cout << ", \n";
-    }
-    std::cout << "\n}" << std::endl;
+    OutputBuffer &out = printv_buffer();
+    write_text(out, vector);
+    out.put('\n');
+    out.flush();
 }
 //
 // TESTS
@@ -225,4 +477,41 @@ void printv_test3()
     printv(double_list2);
     printv(str_list1);
     printv(str_list2);  
+}
+void printv_test4()
+{
+    // output modes
+    std::vector<std::vector<std::string>> ways = {
+        {"purp", "le"},
+        {"p", "ur", "p", "le"}
+    };
+    std::cout.flush();
+    OutputBuffer out(STDOUT_FILENO);
+    write_records(out, ways, OutputMode::text);
+    // {purp, le}
+    // {p, ur, p, le}
+    write_records(out, ways, OutputMode::ndjson);
+    // ["purp","le"]
+    // ["p","ur","p","le"]
+    write_record(out, std::vector<double>{1.5, -2.0, 1e20}, OutputMode::ndjson);
+    // [1.5,-2,1e+20]
+    write_record(out, std::vector<std::string>{"say \"hi\"\n"}, OutputMode::ndjson);
+    // ["say \"hi\"\n"]
+    out.flush();
+    
+    std::ostringstream bytes;
+    {
+        OutputBuffer binary(bytes);
+        write_record(binary, ways, OutputMode::binary);
+    }
+    std::cout << bytes.str().size() << '\n';   // 48, two counts and the words behind their lengths
+    
+    // text follows std::cout's flags like operator<< does
+    printv(std::vector<bool>{true, false});    // {1, 0}
+    std::cout << std::hex << std::boolalpha;
+    printv(std::vector<int>{255, 16});    // {ff, 10}
+    printv(std::vector<bool>{true, false});    // {true, false}
+    std::cout << std::dec << std::noboolalpha << std::setprecision(10);
+    printv(std::vector<double>{1.0 / 3});    // {0.3333333333}
+    std::cout << std::setprecision(6);
 }
\ No newline at end of file
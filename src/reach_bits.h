@@ -0,0 +1,117 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "simd.h"
+//
+// REACHABILITY BITSET
+//
+// bit i of the word array is set when the sum i is reachable
+// adding a number c any amount of times is reach |= reach << c until nothing changes,
+// sweeping the words upwards in place does it in a single pass because every source
+// word below the one being written is already final
+
+inline bool test_bit(const std::vector<std::uint64_t> &words, const std::size_t bit)
+{
+    return (words[bit / 64] >> (bit % 64)) & 1;
+}
+
+inline void set_bit(std::vector<std::uint64_t> &words, const std::size_t bit)
+{
+    words[bit / 64] |= std::uint64_t(1) << (bit % 64);
+}
+
+// shift >= 64, words [w, w + shift / 64) only read words below w so they can go in parallel
+using shift_or_kernel = void(*)(std::uint64_t *words, std::size_t word_count, std::size_t shift);
+
+inline void shift_or_scalar(std::uint64_t *words, const std::size_t word_count, const std::size_t shift)
+{
+    const std::size_t q = shift / 64, r = shift % 64;
+    for(std::size_t w = q; w < word_count; ++w){
+        std::uint64_t src = words[w - q] << r;
+        if(r && w > q) src |= words[w - q - 1] >> (64 - r);
+        words[w] |= src;
+    }
+}
+
+#if DP_X86_DISPATCH
+DP_TARGET_AVX2 inline void shift_or_avx2(std::uint64_t *words, const std::size_t word_count, const std::size_t shift)
+{
+    const std::size_t q = shift / 64, r = shift % 64;
+    if(q < 4 || word_count <= q){
+        shift_or_scalar(words, word_count, shift);
+        return;
+    }
+    words[q] |= words[0] << r;
+    const __m128i left = _mm_set_epi64x(0, static_cast<long long>(r));
+    const __m128i right = _mm_set_epi64x(0, static_cast<long long>(64 - r));    // 64 shifts to zero
+    std::size_t w = q + 1;
+    for(; w + 4 <= word_count; w += 4){
+        const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + w - q));
+        const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + w - q - 1));
+        const __m256i src = _mm256_or_si256(_mm256_sll_epi64(high, left), _mm256_srl_epi64(low, right));
+        __m256i *dst = reinterpret_cast<__m256i*>(words + w);
+        _mm256_storeu_si256(dst, _mm256_or_si256(_mm256_loadu_si256(dst), src));
+    }
+    for(; w < word_count; ++w){
+        std::uint64_t src = words[w - q] << r;
+        if(r) src |= words[w - q - 1] >> (64 - r);
+        words[w] |= src;
+    }
+}
+
+// gcc 12 headers trip -Wmaybe-uninitialized inside the avx-512 intrinsics
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+DP_TARGET_AVX512 inline void shift_or_avx512(std::uint64_t *words, const std::size_t word_count, const std::size_t shift)
+{
+    const std::size_t q = shift / 64, r = shift % 64;
+    if(q < 8 || word_count <= q){
+        shift_or_avx2(words, word_count, shift);
+        return;
+    }
+    words[q] |= words[0] << r;
+    const __m512i left = _mm512_set1_epi64(static_cast<long long>(r));
+    const __m512i right = _mm512_set1_epi64(static_cast<long long>(64 - r));
+    std::size_t w = q + 1;
+    for(; w + 8 <= word_count; w += 8){
+        const __m512i high = _mm512_loadu_si512(words + w - q);
+        const __m512i low = _mm512_loadu_si512(words + w - q - 1);
+        const __m512i src = _mm512_or_si512(_mm512_sllv_epi64(high, left), _mm512_srlv_epi64(low, right));
+        _mm512_storeu_si512(words + w, _mm512_or_si512(_mm512_loadu_si512(words + w), src));
+    }
+    for(; w < word_count; ++w){
+        std::uint64_t src = words[w - q] << r;
+        if(r) src |= words[w - q - 1] >> (64 - r);
+        words[w] |= src;
+    }
+}
+#pragma GCC diagnostic pop
+#endif
+
+inline shift_or_kernel select_shift_or_kernel()
+{
+#if DP_X86_DISPATCH
+    if(cpu_has_avx512()) return shift_or_avx512;
+    if(cpu_has_avx2()) return shift_or_avx2;
+#endif
+    return shift_or_scalar;
+}
+
+// reach |= reach << (k * shift) for every k >= 1
+inline void unbounded_shift_or(std::vector<std::uint64_t> &words, const std::size_t shift)
+{
+    if(shift == 0 || words.empty()) return;
+    if(shift < 64){
+        // sources can be in the same word, close each word under the shift by doubling
+        for(std::size_t w = 0; w < words.size(); ++w){
+            std::uint64_t x = words[w];
+            if(w) x |= words[w - 1] >> (64 - shift);
+            for(std::size_t s = shift; s < 64; s *= 2) x |= x << s;
+            words[w] = x;
+        }
+        return;
+    }
+    static const shift_or_kernel kernel = select_shift_or_kernel();
+    kernel(words.data(), words.size(), shift);
+}
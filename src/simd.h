@@ -0,0 +1,34 @@
+#pragma once
+//
+// SIMD DISPATCH
+//
+// kernels are compiled for several instruction sets with target attributes and
+// picked at runtime, the scalar version is always available as the fallback
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define DP_X86_DISPATCH 1
+#include <immintrin.h>
+#define DP_TARGET_AVX2 __attribute__((target("avx2")))
+#define DP_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define DP_X86_DISPATCH 0
+#endif
+
+inline bool cpu_has_avx2()
+{
+#if DP_X86_DISPATCH
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+#else
+    return false;
+#endif
+}
+
+inline bool cpu_has_avx512()
+{
+#if DP_X86_DISPATCH
+    static const bool has = __builtin_cpu_supports("avx512f");
+    return has;
+#else
+    return false;
+#endif
+}
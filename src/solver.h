@@ -0,0 +1,31 @@
+#pragma once
+#include <concepts>
+#include <type_traits>
+#include <utility>
+//
+// SOLVER TAGS
+//
+// a variant baked into a type, solver<fib_tab> is an empty object whose call is a
+// direct call to fib_tab, so a caller templated on it gets its own copy with the
+// variant inlined into the validation instead of an indirect call through a pointer
+//     fib(50, solver<fib_doubling>)
+// overloaded or templated variants need the pointer type spelled out
+//     fib(50, solver<static_cast<FibFunc>(fib_memo)>)
+template<auto F>
+struct Solver
+{
+    static constexpr auto function = F;
+
+    template<typename... Args>
+    constexpr decltype(auto) operator()(Args&&... args) const
+    {
+        return F(std::forward<Args>(args)...);
+    }
+};
+
+template<auto F>
+inline constexpr Solver<F> solver{};
+
+// F called with Args gives something convertible to R, a tag, a lambda or a plain pointer
+template<typename F, typename R, typename... Args>
+concept SolverFor = std::is_invocable_v<const F&, Args...> && std::convertible_to<std::invoke_result_t<const F&, Args...>, R>;
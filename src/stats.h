@@ -0,0 +1,107 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <utility>
+#include <vector>
+//
+// SOLVER STATS
+//
+// opt-in counters for the solvers, compiled out unless DP_STATS is defined
+//     g++ -DDP_STATS ...
+// each thread counts into its own SolverStats, collect_stats(f) runs f on fresh
+// counters and returns them; without DP_STATS every macro is empty and the counters
+// stay at zero
+struct SolverStats
+{
+    std::uint64_t calls = 0;            // solver function entries, recursive calls included
+    std::uint64_t max_depth = 0;        // deepest recursion
+    std::uint64_t memo_hits = 0;
+    std::uint64_t memo_misses = 0;
+    std::uint64_t memo_entries = 0;     // largest memo size reached
+    std::uint64_t cells = 0;            // table cells written
+    std::uint64_t bytes = 0;            // bytes allocated for memos and tables
+    std::vector<std::pair<const char*, double>> phases;     // name, seconds
+
+    std::uint64_t depth = 0;            // current recursion depth
+
+    void add_phase(const char *name, const double seconds)
+    {
+        for(std::pair<const char*, double> &phase : phases){
+            if(std::strcmp(phase.first, name) == 0){
+                phase.second += seconds;
+                return;
+            }
+        }
+        phases.emplace_back(name, seconds);
+    }
+};
+
+inline std::ostream& operator<<(std::ostream &os, const SolverStats &stats)
+{
+    os << "calls " << stats.calls << ", max depth " << stats.max_depth
+       << ", memo hits " << stats.memo_hits << ", misses " << stats.memo_misses << ", entries " << stats.memo_entries
+       << ", cells " << stats.cells << ", bytes " << stats.bytes;
+    for(const std::pair<const char*, double> &phase : stats.phases)
+        os << ", " << phase.first << ' ' << phase.second * 1e3 << " ms";
+    return os;
+}
+
+inline SolverStats& solver_stats()
+{
+    static thread_local SolverStats stats;
+    return stats;
+}
+
+// f() on fresh counters, the counters from before are put back afterwards
+template<typename F>
+SolverStats collect_stats(F &&f)
+{
+    SolverStats saved = std::exchange(solver_stats(), SolverStats{});
+    f();
+    return std::exchange(solver_stats(), std::move(saved));
+}
+
+#ifdef DP_STATS
+// one per solver call, tracks the depth until the scope ends
+struct StatsCall
+{
+    StatsCall()
+    {
+        SolverStats &stats = solver_stats();
+        ++stats.calls;
+        stats.max_depth = std::max(stats.max_depth, ++stats.depth);
+    }
+    ~StatsCall() { --solver_stats().depth; }
+};
+
+// wall time from here to the end of the scope, added to the phase
+struct StatsPhase
+{
+    explicit StatsPhase(const char *name) : name(name), start(std::chrono::steady_clock::now()) {}
+    ~StatsPhase() { solver_stats().add_phase(name, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()); }
+    const char *name;
+    std::chrono::steady_clock::time_point start;
+};
+
+#define DP_STATS_CONCAT_(a, b) a##b
+#define DP_STATS_CONCAT(a, b) DP_STATS_CONCAT_(a, b)
+#define DP_STATS_CALL() StatsCall DP_STATS_CONCAT(dp_stats_call_, __LINE__)
+#define DP_STATS_PHASE(name) StatsPhase DP_STATS_CONCAT(dp_stats_phase_, __LINE__)(name)
+#define DP_STATS_MEMO(hit) (++((hit) ? solver_stats().memo_hits : solver_stats().memo_misses))
+#define DP_STATS_ENTRIES(n) (solver_stats().memo_entries = std::max<std::uint64_t>(solver_stats().memo_entries, (n)))
+#define DP_STATS_CELLS(n) (solver_stats().cells += (n))
+#define DP_STATS_BYTES(n) (solver_stats().bytes += (n))
+// a frame pushed on an explicit stack of the given depth, counted like a call
+#define DP_STATS_FRAME(depth) (++solver_stats().calls, solver_stats().max_depth = std::max<std::uint64_t>(solver_stats().max_depth, (depth)))
+#else
+#define DP_STATS_CALL() ((void)0)
+#define DP_STATS_PHASE(name) ((void)0)
+#define DP_STATS_MEMO(hit) ((void)0)
+#define DP_STATS_ENTRIES(n) ((void)0)
+#define DP_STATS_CELLS(n) ((void)0)
+#define DP_STATS_BYTES(n) ((void)0)
+#define DP_STATS_FRAME(depth) ((void)0)
+#endif
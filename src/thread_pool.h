@@ -0,0 +1,155 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+//
+// THREAD POOL
+//
+// work stealing: every thread owns a deque, pushes and pops at the back and steals
+// from the front of the others when its own runs dry, so big early tasks get split
+// while the small recent ones stay hot in the cache of the thread that made them
+// the thread that waits on a group runs tasks too, tasks can submit more tasks and
+// wait on them without tying up a thread
+// worker(): each thread has a fixed index in [0, size()), good for per thread scratch;
+// the last index belongs to the outside thread driving the pool, one at a time
+class ThreadPool
+{
+public:
+    // tasks left in a batch, wait() returns when it drops to zero
+    struct Group
+    {
+        std::atomic<std::size_t> left{0};
+    };
+
+    explicit ThreadPool(unsigned threads = 0)
+    {
+        if(!threads) threads = std::max(1u, std::thread::hardware_concurrency());
+        for(unsigned t = 0; t < threads; ++t) queues_.push_back(std::make_unique<Queue>());
+        for(unsigned t = 0; t + 1 < threads; ++t) workers_.emplace_back([this, t]{ work(t); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stop_ = true;
+        }
+        sleep_.notify_all();
+        for(std::thread &worker : workers_) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(queues_.size()); }
+
+    // index of the calling thread, the outside thread is size() - 1
+    unsigned worker() const { return current_pool == this ? current_worker : size() - 1; }
+
+    void submit(Group &group, std::function<void()> task)
+    {
+        group.left.fetch_add(1, std::memory_order_relaxed);
+        Queue &queue = *queues_[worker()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back({ std::move(task), &group });
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            ++pending_;
+        }
+        sleep_.notify_one();
+    }
+
+    // runs queued tasks until every task of the group is done
+    void wait(Group &group)
+    {
+        const unsigned self = worker();
+        while(group.left.load(std::memory_order_acquire)){
+            if(!run_one(self)) std::this_thread::yield();
+        }
+    }
+
+    // f(begin, end) over [0, count) in chunks of at most chunk, returns when all are done
+    template<typename F>
+    void for_each_chunk(const std::size_t count, std::size_t chunk, F f)
+    {
+        chunk = std::max<std::size_t>(chunk, 1);
+        Group group;
+        for(std::size_t begin = 0; begin < count; begin += chunk){
+            const std::size_t end = std::min(begin + chunk, count);
+            submit(group, [&f, begin, end]{ f(begin, end); });
+        }
+        wait(group);
+    }
+
+private:
+    struct Task
+    {
+        std::function<void()> run;
+        Group *group;
+    };
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_;
+    std::atomic<std::size_t> pending_{0};   // queued tasks, raised under sleep_mutex_ so no wake up is lost
+    bool stop_ = false;
+
+    static inline thread_local const ThreadPool *current_pool = nullptr;
+    static inline thread_local unsigned current_worker = 0;
+
+    bool take(Queue &queue, const bool own, Task &task)
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(queue.tasks.empty()) return false;
+        if(own){
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else{
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        return true;
+    }
+
+    bool run_one(const unsigned self)
+    {
+        Task task;
+        bool found = take(*queues_[self], true, task);
+        for(unsigned k = 1; !found && k < size(); ++k)
+            found = take(*queues_[(self + k) % size()], false, task);
+        if(!found) return false;
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        task.run();
+        task.group->left.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    void work(const unsigned self)
+    {
+        current_pool = this;
+        current_worker = self;
+        while(true){
+            if(run_one(self)) continue;
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            sleep_.wait(lock, [this]{ return stop_ || pending_.load(std::memory_order_relaxed); });
+            if(stop_) return;
+        }
+    }
+};
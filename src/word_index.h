@@ -0,0 +1,156 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "stats.h"
+//
+// WORD INDEX
+//
+// aho-corasick automaton over a word bank, one pass over a target lists every
+// bank word ending at every position without allocating
+// transitions are a dense table over the characters the bank actually uses
+class WordIndex
+{
+public:
+    explicit WordIndex(const std::vector<std::string> &word_bank) : words_(word_bank)
+    {
+        DP_STATS_PHASE("index");
+        alphabet_.fill(-1);
+        for(const std::string &word : words_)
+            for(const unsigned char c : word)
+                if(alphabet_[c] < 0) alphabet_[c] = symbols_++;
+        ++symbols_;     // one extra column for characters in no word, always back to the root
+        for(int &symbol : alphabet_)
+            if(symbol < 0) symbol = symbols_ - 1;
+
+        // trie
+        std::vector<std::vector<int>> node_words(1);
+        next_.assign(symbols_, -1);
+        for(std::size_t w = 0; w < words_.size(); ++w){
+            if(words_[w].empty()) continue;
+            int node = 0;
+            for(const unsigned char c : words_[w]){
+                int &child = next_[node * symbols_ + alphabet_[c]];
+                if(child < 0){
+                    child = static_cast<int>(node_words.size());
+                    node_words.emplace_back();
+                    next_.resize(next_.size() + symbols_, -1);
+                }
+                node = next_[node * symbols_ + alphabet_[c]];
+            }
+            node_words[node].push_back(static_cast<int>(w));
+        }
+        const int nodes = static_cast<int>(node_words.size());
+
+        // outputs in csr form, duplicates of a word stay in bank order
+        word_begin_.assign(nodes + 1, 0);
+        for(int node = 0; node < nodes; ++node)
+            word_begin_[node + 1] = word_begin_[node] + static_cast<int>(node_words[node].size());
+        word_ids_.reserve(word_begin_[nodes]);
+        for(const std::vector<int> &ids : node_words)
+            word_ids_.insert(word_ids_.end(), ids.begin(), ids.end());
+
+        // failure links in bfs order turn the trie into a full automaton, dict_ skips to
+        // the longest proper suffix that ends a word
+        std::vector<int> fail(nodes, 0);
+        dict_.assign(nodes, -1);
+        std::queue<int> queue;
+        for(int s = 0; s < symbols_; ++s){
+            int &child = next_[s];
+            if(child < 0) child = 0;
+            else queue.push(child);
+        }
+        while(!queue.empty()){
+            const int node = queue.front();
+            queue.pop();
+            const int link = fail[node];
+            dict_[node] = has_words(link) ? link : dict_[link];
+            for(int s = 0; s < symbols_; ++s){
+                int &child = next_[node * symbols_ + s];
+                if(child < 0){
+                    child = next_[link * symbols_ + s];
+                }
+                else{
+                    fail[child] = next_[link * symbols_ + s];
+                    queue.push(child);
+                }
+            }
+        }
+    }
+
+    const std::vector<std::string>& words() const { return words_; }
+    const std::string& word(const int w) const { return words_[w]; }
+
+    // calls f(end, w) for each occurrence of words_[w] at [end - size, end), ordered by
+    // end, then by start, then by bank order
+    template<typename F>
+    void for_each_match(const std::string_view text, F &&f) const
+    {
+        // O(|text| + matches) time
+        int node = 0;
+        for(std::size_t i = 0; i < text.size(); ++i){
+            node = next_[node * symbols_ + alphabet_[static_cast<unsigned char>(text[i])]];
+            for(int out = has_words(node) ? node : dict_[node]; out >= 0; out = dict_[out])
+                for(int k = word_begin_[out]; k < word_begin_[out + 1]; ++k)
+                    f(i + 1, word_ids_[k]);
+        }
+    }
+
+private:
+    std::vector<std::string> words_;
+    std::array<int, 256> alphabet_;
+    int symbols_ = 0;
+    std::vector<int> next_;         // node * symbols_ + symbol -> node
+    std::vector<int> dict_;         // node -> nearest suffix node with words, -1 if none
+    std::vector<int> word_begin_;   // node -> range in word_ids_
+    std::vector<int> word_ids_;
+
+    bool has_words(const int node) const { return word_begin_[node] != word_begin_[node + 1]; }
+};
+//
+// MATCH STARTS
+//
+// the words matching at each start of a target in bank order, in csr form:
+// ids[begin[i] .. begin[i + 1]) are the words of target[i ..], for i in [0, m]
+struct MatchStarts
+{
+    std::vector<int> begin;
+    std::vector<int> ids;
+};
+
+inline MatchStarts match_starts(const std::string_view target, const WordIndex &index)
+{
+    // O(m + matches log matches) time
+    // O(m + matches) space
+    MatchStarts starts;
+    starts.begin.assign(target.size() + 2, 0);
+    index.for_each_match(target, [&](const std::size_t end, const int word){
+        ++starts.begin[end - index.word(word).size() + 2];
+    });
+    for(std::size_t i = 2; i < starts.begin.size(); ++i)
+        starts.begin[i] += starts.begin[i - 1];
+    starts.ids.resize(starts.begin.back());
+    index.for_each_match(target, [&](const std::size_t end, const int word){
+        starts.ids[starts.begin[end - index.word(word).size() + 1]++] = word;
+    });
+    for(std::size_t i = 0; i < target.size(); ++i)
+        std::sort(starts.ids.begin() + starts.begin[i], starts.ids.begin() + starts.begin[i + 1]);
+    return starts;
+}
+
+// reach[i] is true when target[i ..] can be constructed from the bank
+inline std::vector<bool> suffix_reach(const std::string_view target, const WordIndex &index, const MatchStarts &starts)
+{
+    // O(m + matches) time
+    // O(m) space
+    std::vector<bool> reach(target.size() + 1, false);
+    reach[target.size()] = true;
+    for(std::size_t i = target.size(); i-- > 0;)
+        for(int k = starts.begin[i]; k < starts.begin[i + 1] && !reach[i]; ++k)
+            reach[i] = reach[i + index.word(starts.ids[k]).size()];
+    return reach;
+}